@@ -0,0 +1,130 @@
+#pragma once
+
+// Timing and JSON output for the bench_* targets. Self-contained, so that the benchmarks build
+// wherever the tests do, and kept to what the benchmarks here need: a median time per call and a
+// flat list of results that a script can diff between two releases.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace bench {
+
+// Makes the compiler assume value, and everything it points to, is read.
+template<typename T>
+inline void doNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Makes the compiler assume all memory has changed, so inputs are loaded again.
+inline void clobberMemory() { asm volatile("" : : : "memory"); }
+
+struct Timing {
+    double        nsPerCall;
+    std::uint64_t calls;
+};
+
+// The batch size is doubled until one batch takes batchTime, then the median of several batches
+// is taken, which keeps a single preempted batch from skewing the result.
+template<typename Body>
+Timing measure(Body&&                   body,
+               std::chrono::nanoseconds batchTime = std::chrono::milliseconds{20}) {
+    using clock = std::chrono::steady_clock;
+
+    auto const runBatch = [&](std::uint64_t batch) {
+        auto const start = clock::now();
+        for(std::uint64_t call = 0; call < batch; ++call) { body(); }
+        return clock::now() - start;
+    };
+
+    std::uint64_t batch = 1;
+    while(runBatch(batch) < batchTime && batch < (std::uint64_t{1} << 32)) { batch *= 2; }
+
+    std::array<double, 7> perCall{};
+    for(double& run : perCall) {
+        run = std::chrono::duration<double, std::nano>(runBatch(batch)).count()
+            / static_cast<double>(batch);
+    }
+    std::ranges::sort(perCall);
+    return {perCall[perCall.size() / 2], batch * perCall.size()};
+}
+
+using Value = std::variant<std::string_view, bool, double, std::uint64_t>;
+
+struct Field {
+    std::string_view key;
+    Value            value;
+};
+
+// {"benchmark": ..., "context": {...}, "results": [{...}, ...]}
+class JsonReport {
+public:
+    JsonReport(std::string_view             benchmark,
+               std::initializer_list<Field> context)
+      : name{benchmark}
+      , contextObject{object(context)} {}
+
+    void add(std::initializer_list<Field> result) { results.push_back(object(result)); }
+
+    // To path, or to stdout without one. False if the file cannot be written.
+    bool write(char const* path) const {
+        std::FILE* const file = path == nullptr ? stdout : std::fopen(path, "w");
+        if(file == nullptr) { return false; }
+        std::fprintf(file,
+                     "{\n  \"benchmark\": %s,\n  \"context\": %s,\n  \"results\": [",
+                     quoted(name).c_str(),
+                     contextObject.c_str());
+        for(std::size_t index = 0; index < results.size(); ++index) {
+            std::fprintf(file, "%s\n    %s", index == 0 ? "" : ",", results[index].c_str());
+        }
+        std::fprintf(file, "\n  ]\n}\n");
+        return path == nullptr || std::fclose(file) == 0;
+    }
+
+private:
+    static std::string quoted(std::string_view text) {
+        std::string out = "\"";
+        for(char const character : text) {
+            if(character == '"' || character == '\\') { out += '\\'; }
+            out += character;
+        }
+        return out + '"';
+    }
+
+    static std::string object(std::initializer_list<Field> fields) {
+        std::string out = "{";
+        for(Field const& field : fields) {
+            if(out.size() != 1) { out += ", "; }
+            out += quoted(field.key) + ": ";
+            std::visit(
+              [&]<typename T>(T const& value) {
+                  if constexpr(std::is_same_v<T, std::string_view>) {
+                      out += quoted(value);
+                  } else if constexpr(std::is_same_v<T, bool>) {
+                      out += value ? "true" : "false";
+                  } else if constexpr(std::is_same_v<T, double>) {
+                      std::array<char, 32> buffer{};
+                      std::snprintf(buffer.data(), buffer.size(), "%.3f", value);
+                      out += buffer.data();
+                  } else {
+                      out += std::to_string(value);
+                  }
+              },
+              field.value);
+        }
+        return out + "}";
+    }
+
+    std::string_view         name;
+    std::string              contextObject;
+    std::vector<std::string> results;
+};
+
+}   // namespace bench
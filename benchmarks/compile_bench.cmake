@@ -0,0 +1,56 @@
+# Run by the bench_compile target: rebuilds each of its workload targets in turn, timing the build, and writes the
+# times as JSON in the layout of the other bench_* reports. All of them were built once before this runs, so touching
+# the source rebuilds the one target that is asked for and nothing it depends on.
+#
+#   BUILD_DIR  the build tree the targets are in
+#   CASES      target:sites:fmt_check entries, separated by commas
+#   SOURCE     the workload source the targets share
+#   COMPILER   for the context of the report
+#   OUTPUT     the report
+
+cmake_minimum_required(VERSION 3.28)
+
+string(REPLACE "," ";" cases "${CASES}")
+set(results "")
+foreach(case IN LISTS cases)
+    string(REPLACE ":" ";" fields "${case}")
+    list(GET fields 0 target)
+    list(GET fields 1 sites)
+    list(GET fields 2 check)
+
+    file(TOUCH "${SOURCE}")
+    string(TIMESTAMP start "%s%f" UTC)
+    execute_process(
+        COMMAND "${CMAKE_COMMAND}" --build "${BUILD_DIR}" --target ${target}
+        RESULT_VARIABLE failed
+        OUTPUT_QUIET)
+    string(TIMESTAMP stop "%s%f" UTC)
+    if(failed)
+        message(FATAL_ERROR "building ${target} failed")
+    endif()
+
+    math(EXPR microseconds "${stop} - ${start}")
+    math(EXPR milliseconds "${microseconds} / 1000")
+    if(check)
+        set(check true)
+    else()
+        set(check false)
+    endif()
+    message(STATUS "${sites} sites, fmt check ${check}: ${milliseconds} ms")
+
+    # What a site adds, over the first and smallest case of the same check setting - which is mostly the headers.
+    set(result "\"sites\": ${sites}, \"fmt_check\": ${check}, \"ms\": ${milliseconds}")
+    if(NOT DEFINED base_${check})
+        set(base_${check} ${microseconds} ${sites})
+    else()
+        list(GET base_${check} 0 base_microseconds)
+        list(GET base_${check} 1 base_sites)
+        math(EXPR per_site "(${microseconds} - ${base_microseconds}) / (${sites} - ${base_sites})")
+        string(APPEND result ", \"us_per_site\": ${per_site}")
+    endif()
+    list(APPEND results "{${result}}")
+endforeach()
+
+list(JOIN results ",\n    " results)
+file(WRITE "${OUTPUT}"
+     "{\n  \"benchmark\": \"compile\",\n  \"context\": {\"compiler\": \"${COMPILER}\"},\n  \"results\": [\n    ${results}\n  ]\n}\n")
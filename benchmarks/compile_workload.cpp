@@ -0,0 +1,86 @@
+// Print call sites for the bench_compile target, which times the build of this file for several
+// values of COMPILE_WORKLOAD_GROUPS. Every group adds four sites, each with a format string of its
+// own: a print with lvalues, one with temporaries, a leveled print and a staticPrint. Only the
+// build time matters; running it does nothing interesting.
+#include "remote_fmt/remote_fmt.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+using namespace sc::literals;
+
+// Not in an anonymous namespace: the sites below take these types, and would otherwise have
+// internal linkage and be dropped unused.
+namespace compile_workload {
+
+inline std::byte volatile dataRegister{};
+
+struct RegisterBackend {
+    static void write(std::span<std::byte const> data) {
+        for(std::byte const b : data) { dataRegister = b; }
+    }
+};
+
+using Printer = remote_fmt::Printer<RegisterBackend>;
+
+struct Inputs {
+    std::uint8_t                channel;
+    std::uint16_t               raw;
+    std::int32_t                offset;
+    std::uint32_t               tick;
+    float                       voltage;
+    std::string_view            name;
+    std::array<std::uint8_t, 4> address;
+};
+
+}   // namespace compile_workload
+
+using compile_workload::Inputs;
+using compile_workload::Printer;
+
+#define COMPILE_WORKLOAD_STR_(x)    #x
+#define COMPILE_WORKLOAD_STR(x)     COMPILE_WORKLOAD_STR_(x)
+#define COMPILE_WORKLOAD_CAT_(a, b) a##b
+#define COMPILE_WORKLOAD_CAT(a, b)  COMPILE_WORKLOAD_CAT_(a, b)
+
+// __COUNTER__ is new on every expansion, so no two sites share a format string and none of them
+// is checked or instantiated only once for several sites.
+#define COMPILE_WORKLOAD_ID COMPILE_WORKLOAD_STR(__COUNTER__)
+
+#define COMPILE_WORKLOAD_GROUP()                                                              \
+    void COMPILE_WORKLOAD_CAT(group, __COUNTER__)(Printer & printer, Inputs const& in) {      \
+        printer.print("tick " COMPILE_WORKLOAD_ID " {} offset {}"_sc, in.tick, in.offset);    \
+        printer.print("supply " COMPILE_WORKLOAD_ID " {:.2f} V on ch{}"_sc,                   \
+                      in.voltage * 2.0F,                                                      \
+                      static_cast<std::uint8_t>(in.channel + 1));                             \
+        printer.print<remote_fmt::Level::warning>("task " COMPILE_WORKLOAD_ID " {} took {}"_sc, \
+                                                  in.name,                                    \
+                                                  in.tick);                                   \
+        Printer::staticPrint("ip " COMPILE_WORKLOAD_ID " {} port {:#06x}"_sc,                 \
+                             in.address,                                                      \
+                             in.raw);                                                         \
+    }
+
+// The macro is passed by name and called in the expansion, so that each group gets its own ids.
+#define COMPILE_WORKLOAD_1(group) group()
+#define COMPILE_WORKLOAD_10(group) \
+    group() group() group() group() group() group() group() group() group() group()
+#define COMPILE_WORKLOAD_100(group)                                                    \
+    COMPILE_WORKLOAD_10(group) COMPILE_WORKLOAD_10(group) COMPILE_WORKLOAD_10(group)   \
+    COMPILE_WORKLOAD_10(group) COMPILE_WORKLOAD_10(group) COMPILE_WORKLOAD_10(group)   \
+    COMPILE_WORKLOAD_10(group) COMPILE_WORKLOAD_10(group) COMPILE_WORKLOAD_10(group)   \
+    COMPILE_WORKLOAD_10(group)
+#define COMPILE_WORKLOAD_1000(group)                                                   \
+    COMPILE_WORKLOAD_100(group) COMPILE_WORKLOAD_100(group) COMPILE_WORKLOAD_100(group) \
+    COMPILE_WORKLOAD_100(group) COMPILE_WORKLOAD_100(group) COMPILE_WORKLOAD_100(group) \
+    COMPILE_WORKLOAD_100(group) COMPILE_WORKLOAD_100(group) COMPILE_WORKLOAD_100(group) \
+    COMPILE_WORKLOAD_100(group)
+
+#ifndef COMPILE_WORKLOAD_GROUPS
+    #define COMPILE_WORKLOAD_GROUPS 10
+#endif
+
+COMPILE_WORKLOAD_CAT(COMPILE_WORKLOAD_, COMPILE_WORKLOAD_GROUPS)(COMPILE_WORKLOAD_GROUP)
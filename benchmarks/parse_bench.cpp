@@ -0,0 +1,320 @@
+// Throughput of remote_fmt::parse, built once per catalog mode by the bench_parse target. The
+// streams are made by the real Printer, like the fuzzer's seeds, from one message kind at a time -
+// which shows the parse path each kind takes - and from all of them mixed, clean and with 1% of
+// the bytes corrupted. The catalog build adds a stream of mostly cataloged strings and enum names,
+// resolved through the catalog the generator wrote for this binary. The report goes to the path
+// given as the only argument, or to stdout.
+#include "bench_harness.hpp"
+#include "remote_fmt/parser.hpp"
+#include "remote_fmt/remote_fmt.hpp"
+
+#ifdef PARSE_BENCH_CATALOG_FILE
+    #include "remote_fmt/catalog_helpers.hpp"
+#endif
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <expected>
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace sc::literals;
+using namespace std::literals;
+
+namespace {
+
+struct VectorBackend {
+    std::vector<std::byte> memory;
+
+    void write(std::span<std::byte const> data) {
+        memory.insert(memory.end(), data.begin(), data.end());
+    }
+};
+
+using Printer = remote_fmt::Printer<VectorBackend>;
+
+enum class State : std::uint8_t { idle, running, fault, recovering };
+
+struct Reading {
+    std::uint8_t channel;
+    float        value;
+};
+
+// Prints message number i of one kind. The values change with i, so that sizes and
+// digits vary the way they do in a real log.
+using Message = void (*)(Printer&, std::uint32_t);
+
+struct Kind {
+    std::string_view name;
+    Message          print;
+};
+
+constexpr std::array kinds{
+  Kind{"int",
+       [](Printer& p, std::uint32_t i) {
+           p.print("tick {} ch{} offset {}"_sc,
+                   i * 977U,
+                   static_cast<std::uint8_t>(i),
+                   -static_cast<std::int32_t>(i * 31U));
+       }},
+  Kind{"float",
+       [](Printer& p, std::uint32_t i) {
+           p.print("supply {:.2f} V at {:.3f}"_sc,
+                   3.3F + static_cast<float>(i % 100) / 50.0F,
+                   0.125 * i);
+       }},
+  Kind{"bool",
+       [](Printer& p, std::uint32_t i) {
+           p.print("enabled {} overrun {} ready {}"_sc,
+                   (i & 1U) != 0,
+                   (i & 2U) != 0,
+                   (i & 4U) != 0);
+       }},
+  Kind{"string",
+       [](Printer& p, std::uint32_t i) {
+           constexpr std::array names{"motor_left"sv, "motor_right"sv, "pump"sv, "fan"sv};
+           p.print("{} state {}"_sc, names[i % names.size()], "nominal"sv);
+       }},
+  Kind{"range",
+       [](Printer& p, std::uint32_t i) {
+           std::array<std::int16_t, 16> samples{};
+           for(std::size_t n = 0; n < samples.size(); ++n) {
+               samples[n] = static_cast<std::int16_t>((i + n) * 131U);
+           }
+           p.print("samples {}"_sc, samples);
+       }},
+  Kind{"hex_range",
+       [](Printer& p, std::uint32_t i) {
+           std::array<std::uint8_t, 32> packet{};
+           for(std::size_t n = 0; n < packet.size(); ++n) {
+               packet[n] = static_cast<std::uint8_t>((i + n) * 29U);
+           }
+           p.print("rx {::02x} crc {:#06x}"_sc, packet, static_cast<std::uint16_t>(i * 7U));
+       }},
+  Kind{"float_range",
+       [](Printer& p, std::uint32_t i) {
+           std::array<float, 16> spectrum{};
+           for(std::size_t n = 0; n < spectrum.size(); ++n) {
+               spectrum[n] = static_cast<float>(i + n) * 0.25F;
+           }
+           p.print("spectrum {::.1f}"_sc, spectrum);
+       }},
+  Kind{"map",
+       [](Printer& p, std::uint32_t i) {
+           std::map<std::uint16_t, std::uint32_t> counters;
+           for(std::uint16_t n = 0; n < 6; ++n) { counters.emplace(n, (i + n) * 100'003U); }
+           p.print("counters {}"_sc, counters);
+       }},
+  Kind{"duration",
+       [](Printer& p, std::uint32_t i) {
+           p.print("timeout {} latency {}"_sc,
+                   std::chrono::milliseconds{250 + i % 1000},
+                   std::chrono::microseconds{40 + i});
+       }},
+  Kind{"optional/expected/variant",
+       [](Printer& p, std::uint32_t i) {
+           std::optional<std::uint16_t> retries;
+           if(i % 3 != 0) { retries = static_cast<std::uint16_t>(i); }
+           std::expected<std::int32_t, std::uint8_t> result{static_cast<std::int32_t>(i)};
+           if(i % 5 == 0) { result = std::unexpected{static_cast<std::uint8_t>(i)}; }
+           std::variant<std::int32_t, float> setpoint{static_cast<float>(i) * 0.5F};
+           if(i % 2 == 0) { setpoint = static_cast<std::int32_t>(i); }
+           p.print("retries {} result {} setpoint {}"_sc, retries, result, setpoint);
+       }},
+  Kind{"enum",
+       [](Printer& p, std::uint32_t i) {
+           p.print("state {} -> {}"_sc, static_cast<State>(i % 4), static_cast<State>((i + 1) % 4));
+       }},
+  Kind{"struct",
+       [](Printer& p, std::uint32_t i) {
+           p.print("reading {}"_sc,
+                   Reading{static_cast<std::uint8_t>(i), static_cast<float>(i) * 1.5F});
+       }},
+  Kind{"styled",
+       [](Printer& p, std::uint32_t i) {
+           p.print("fault {}"_sc,
+                   fmt::styled(static_cast<std::int32_t>(i),
+                               fmt::fg(fmt::color::red) | fmt::emphasis::bold));
+       }},
+};
+
+// Ranges three levels deep, as a parser that recurses per level sees them.
+void printNested(Printer&      p,
+                 std::uint32_t i) {
+    std::vector<std::vector<std::vector<std::uint8_t>>> grid(3);
+    for(std::size_t row = 0; row < grid.size(); ++row) {
+        grid[row].resize(3);
+        for(std::size_t column = 0; column < grid[row].size(); ++column) {
+            grid[row][column].assign(4, static_cast<std::uint8_t>(i + row + column));
+        }
+    }
+    std::map<std::uint16_t, std::vector<std::pair<std::uint8_t, float>>> history;
+    for(std::uint16_t key = 0; key < 3; ++key) {
+        history[key] = {
+          {static_cast<std::uint8_t>(key),     static_cast<float>(i)},
+          {static_cast<std::uint8_t>(key + 1), static_cast<float>(i + key)}
+        };
+    }
+    p.print("grid {} history {}"_sc, grid, history);
+}
+
+#ifdef PARSE_BENCH_CATALOG_FILE
+// Format string, string arguments, enum names and the struct schema all sent as catalog ids.
+void printCataloged(Printer&      p,
+                    std::uint32_t i) {
+    constexpr auto motor = "motor_left"_sc;
+    constexpr auto pump  = "coolant_pump"_sc;
+    if(i % 2 == 0) {
+        p.print("{} in {} from {} reading {}"_sc,
+                motor,
+                static_cast<State>(i % 4),
+                "controller"_sc,
+                Reading{1, 2.5F});
+    } else {
+        p.print("{} in {} from {} reading {}"_sc,
+                pump,
+                static_cast<State>(i % 4),
+                "watchdog"_sc,
+                Reading{2, 0.5F});
+    }
+}
+#endif
+
+constexpr std::size_t streamBytes = 256 * 1024;
+
+// Messages of the given kinds, in turn, until the stream holds about streamBytes.
+std::vector<std::byte> makeStream(std::span<Message const> messages) {
+    Printer       printer{};
+    std::uint32_t index{};
+    while(printer.get_com_backend().memory.size() < streamBytes) {
+        messages[index % messages.size()](printer, index);
+        ++index;
+    }
+    return std::move(printer.get_com_backend().memory);
+}
+
+// Flips one byte in a hundred to a random value, from a fixed seed so that every run and every
+// release sees the same damage.
+std::vector<std::byte> corrupt(std::vector<std::byte> stream) {
+    std::uint32_t state = 0x1234'5678U;
+    auto const    next  = [&] {
+        state ^= state << 13U;
+        state ^= state >> 17U;
+        state ^= state << 5U;
+        return state;
+    };
+    for(std::byte& b : stream) {
+        if(next() % 100 == 0) { b = static_cast<std::byte>(next()); }
+    }
+    return stream;
+}
+
+struct Pass {
+    std::size_t messages;
+    // Reported through the error callback.
+    std::size_t errors;
+    // Frames that did not parse, each costing a resync.
+    std::size_t resyncs;
+};
+
+// Parses a whole stream the way a host reading from a link does: after a frame that does not
+// parse, it resyncs one byte further on.
+Pass parseStream(std::span<std::byte const>                          stream,
+                 std::unordered_map<std::uint16_t, std::string> const& catalog) {
+    Pass pass{};
+    auto onError = [&](std::string_view) { ++pass.errors; };
+    while(!stream.empty()) {
+        auto const [message, remaining, discarded] = remote_fmt::parse(stream, catalog, onError);
+        static_cast<void>(discarded);
+        if(message) {
+            bench::doNotOptimize(message->data());
+            ++pass.messages;
+            stream = remaining;
+        } else {
+            if(remaining.empty()) { break; }
+            ++pass.resyncs;
+            stream = remaining.subspan(1);
+        }
+    }
+    return pass;
+}
+
+void run(bench::JsonReport&                                    report,
+         std::string_view                                      name,
+         std::vector<std::byte> const&                         stream,
+         std::unordered_map<std::uint16_t, std::string> const& catalog) {
+    Pass const          pass   = parseStream(stream, catalog);
+    bench::Timing const timing
+      = bench::measure([&] { bench::doNotOptimize(parseStream(stream, catalog)); },
+                       std::chrono::milliseconds{100});
+    double const seconds = timing.nsPerCall / 1e9;
+    report.add({
+      {           "corpus",                                              name},
+      {      "stream_bytes",                   std::uint64_t{stream.size()}},
+      {          "messages",                  std::uint64_t{pass.messages}},
+      {            "errors",                    std::uint64_t{pass.errors}},
+      {           "resyncs",                   std::uint64_t{pass.resyncs}},
+      {"messages_per_second", static_cast<double>(pass.messages) / seconds},
+      {     "mb_per_second", static_cast<double>(stream.size()) / 1e6 / seconds}
+    });
+}
+
+}   // namespace
+
+int main(int    argc,
+         char** argv) {
+    std::unordered_map<std::uint16_t, std::string> catalog;
+#ifdef PARSE_BENCH_CATALOG_FILE
+    auto loaded = remote_fmt::parseStringConstantsFromJsonFile(PARSE_BENCH_CATALOG_FILE);
+    if(!loaded) {
+        std::fprintf(stderr, "%s\n", loaded.error().c_str());
+        return 1;
+    }
+    catalog = std::move(*loaded);
+#endif
+
+    bench::JsonReport report{
+      "parse",
+      {{"catalog", remote_fmt::use_catalog}, {"stream_bytes", std::uint64_t{streamBytes}}}
+    };
+
+    std::vector<Message> all;
+    for(Kind const& kind : kinds) {
+        std::array const one{kind.print};
+        run(report, kind.name, makeStream(one), catalog);
+        all.push_back(kind.print);
+    }
+
+    std::vector<std::byte> const clean = makeStream(all);
+    run(report, "mixed", clean, catalog);
+    run(report, "mixed_corrupt_1pct", corrupt(clean), catalog);
+
+    std::array const nested{&printNested};
+    run(report, "nested_ranges", makeStream(nested), catalog);
+
+#ifdef PARSE_BENCH_CATALOG_FILE
+    std::array const cataloged{&printCataloged};
+    run(report, "catalog_heavy", makeStream(cataloged), catalog);
+#endif
+
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+    char const* const path = argc > 1 ? argv[1] : nullptr;
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+    return report.write(path) ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+// Time and wire size of one print for representative argument mixes, built once per catalog mode
+// by the bench_serialize target. Each mix runs against a backend that drops the bytes, which
+// leaves the cost of serializing, and one that appends them to a vector, which adds a realistic
+// copy. The report goes to the path given as the only argument, or to stdout.
+#include "bench_harness.hpp"
+#include "remote_fmt/remote_fmt.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <map>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+using namespace sc::literals;
+using namespace std::literals;
+
+namespace {
+
+struct NullBackend {
+    static void write(std::span<std::byte const> data) { bench::doNotOptimize(data.data()); }
+};
+
+struct VectorBackend {
+    std::vector<std::byte> memory;
+
+    void write(std::span<std::byte const> data) {
+        memory.insert(memory.end(), data.begin(), data.end());
+    }
+};
+
+enum class State : std::uint8_t { idle, running, fault };
+
+struct Reading {
+    std::uint8_t channel;
+    float        value;
+};
+
+struct Inputs {
+    std::uint8_t                             channel;
+    std::uint16_t                            raw;
+    std::int32_t                             offset;
+    std::uint64_t                            uptime;
+    float                                    voltage;
+    double                                   position;
+    bool                                     enabled;
+    std::string_view                         name;
+    std::vector<std::int32_t>                samples;
+    std::vector<float>                       spectrum;
+    std::map<std::uint16_t, std::uint32_t>   counters;
+    std::chrono::milliseconds                timeout;
+    std::chrono::microseconds                latency;
+    std::vector<std::chrono::microseconds>   latencies;
+    std::optional<std::uint16_t>             retries;
+    std::expected<std::int32_t, std::uint8_t> result;
+    std::variant<std::int32_t, float>        setpoint;
+    State                                    state;
+    std::array<State, 32>                    states;
+    std::vector<Reading>                     readings;
+};
+
+// Read from a volatile, so that no mix is folded into a constant.
+std::uint32_t volatile seed{7};
+
+Inputs makeInputs() {
+    std::uint32_t const s = seed;
+    Inputs              in{};
+    in.channel  = static_cast<std::uint8_t>(s);
+    in.raw      = static_cast<std::uint16_t>(s * 397U);
+    in.offset   = -static_cast<std::int32_t>(s * 1000U);
+    in.uptime   = std::uint64_t{s} << 36U;
+    in.voltage  = 3.3F + static_cast<float>(s) / 100.0F;
+    in.position = 12.5 * s;
+    in.enabled  = (s & 1U) != 0;
+    in.name     = "motor_left"sv;
+    for(std::uint32_t i = 0; i < 16; ++i) {
+        in.samples.push_back(static_cast<std::int32_t>((s + i) * 131U) - 1000);
+    }
+    for(std::uint32_t i = 0; i < 64; ++i) {
+        in.spectrum.push_back(static_cast<float>(s + i) * 0.25F);
+    }
+    for(std::uint32_t i = 0; i < 8; ++i) {
+        in.counters.emplace(static_cast<std::uint16_t>(i * 10), (s + i) * 100'003U);
+    }
+    in.timeout = std::chrono::milliseconds{250 + s};
+    in.latency = std::chrono::microseconds{40 + s};
+    for(std::uint32_t i = 0; i < 16; ++i) { in.latencies.emplace_back(10 * (s + i)); }
+    in.retries  = static_cast<std::uint16_t>(s + 2);
+    in.result   = std::unexpected{static_cast<std::uint8_t>(s)};
+    in.setpoint = 0.5F * static_cast<float>(s);
+    in.state    = static_cast<State>(s % 3);
+    for(std::size_t i = 0; i < in.states.size(); ++i) {
+        in.states[i] = static_cast<State>((s + i) % 3);
+    }
+    for(std::uint32_t i = 0; i < 8; ++i) {
+        in.readings.push_back({static_cast<std::uint8_t>(i), static_cast<float>(s + i) * 1.5F});
+    }
+    return in;
+}
+
+template<typename Printer>
+void clear(Printer& printer) {
+    if constexpr(requires { printer.get_com_backend().memory; }) {
+        printer.get_com_backend().memory.clear();
+    }
+}
+
+// One entry per mix: its name and a print call, generic over the printer.
+template<typename Printer>
+auto mixes() {
+    using Mix = std::pair<std::string_view, void (*)(Printer&, Inputs const&)>;
+    return std::array{
+      Mix{"int",
+          [](Printer& p, Inputs const& in) { p.print("tick {}"_sc, in.offset); }},
+      Mix{"ints",
+          [](Printer& p, Inputs const& in) {
+              p.print("ch{} raw {} offset {} up {}"_sc, in.channel, in.raw, in.offset, in.uptime);
+          }},
+      Mix{"floats",
+          [](Printer& p, Inputs const& in) {
+              p.print("supply {:.2f} V at {:.3f}"_sc, in.voltage, in.position);
+          }},
+      Mix{"string",
+          [](Printer& p, Inputs const& in) {
+              p.print("axis {} enabled {}"_sc, in.name, in.enabled);
+          }},
+      Mix{"vector<int32>[16]",
+          [](Printer& p, Inputs const& in) { p.print("samples {}"_sc, in.samples); }},
+      Mix{"vector<float>[64]",
+          [](Printer& p, Inputs const& in) { p.print("spectrum {::.1f}"_sc, in.spectrum); }},
+      Mix{"map<uint16,uint32>[8]",
+          [](Printer& p, Inputs const& in) { p.print("counters {}"_sc, in.counters); }},
+      Mix{"durations",
+          [](Printer& p, Inputs const& in) {
+              p.print("timeout {} latency {}"_sc, in.timeout, in.latency);
+          }},
+      Mix{"vector<microseconds>[16]",
+          [](Printer& p, Inputs const& in) { p.print("latencies {}"_sc, in.latencies); }},
+      Mix{"optional/expected/variant",
+          [](Printer& p, Inputs const& in) {
+              p.print("retries {} result {} setpoint {}"_sc, in.retries, in.result, in.setpoint);
+          }},
+      Mix{"styled",
+          [](Printer& p, Inputs const& in) {
+              p.print("fault {}"_sc,
+                      fmt::styled(in.offset, fmt::fg(fmt::color::red) | fmt::emphasis::bold));
+          }},
+      Mix{"enum",
+          [](Printer& p, Inputs const& in) { p.print("state {}"_sc, in.state); }},
+      Mix{"array<enum>[32]",
+          [](Printer& p, Inputs const& in) { p.print("states {}"_sc, in.states); }},
+      Mix{"vector<struct>[8]",
+          [](Printer& p, Inputs const& in) { p.print("readings {}"_sc, in.readings); }},
+    };
+}
+
+template<typename Backend>
+void run(bench::JsonReport& report,
+         std::string_view   backend,
+         Inputs const&      in) {
+    using Printer = remote_fmt::Printer<Backend>;
+    using Sizer   = remote_fmt::Printer<VectorBackend>;
+    auto const sized = mixes<Sizer>();
+    auto const timed = mixes<Printer>();
+
+    for(std::size_t index = 0; index < timed.size(); ++index) {
+        auto const& [name, print] = timed[index];
+
+        // Every call sends the same frame, so one call through a vector gives its size.
+        Sizer sizer{};
+        sized[index].second(sizer, in);
+
+        Printer             printer{};
+        bench::Timing const timing = bench::measure([&] {
+            clear(printer);
+            bench::clobberMemory();
+            print(printer, in);
+        });
+
+        report.add({
+          {          "name",                                    name},
+          {       "backend",                                 backend},
+          {   "ns_per_call",                        timing.nsPerCall},
+          {"bytes_per_call", std::uint64_t{sizer.get_com_backend().memory.size()}},
+          {         "calls",                            timing.calls}
+        });
+    }
+}
+
+}   // namespace
+
+int main(int    argc,
+         char** argv) {
+    Inputs const      in = makeInputs();
+    bench::JsonReport report{
+      "serialize",
+      {{"catalog", remote_fmt::use_catalog}, {"type_erased", remote_fmt::type_erased}}
+    };
+    run<NullBackend>(report, "null", in);
+    run<VectorBackend>(report, "vector", in);
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+    char const* const path = argc > 1 ? argv[1] : nullptr;
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+    return report.write(path) ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+// A firmware-sized mix of print call sites, built once per serializer mode and backend kind by the
+// bench_size target. Only the code size of the result matters; running it does nothing
+// interesting.
+#include "remote_fmt/remote_fmt.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+using namespace sc::literals;
+
+namespace {
+
+// Stands in for a UART data register: the compiler has to keep every byte.
+std::byte volatile dataRegister{};
+
+struct RegisterBackend {
+#ifdef SIZE_WORKLOAD_RESERVE
+    // As DmaBackend has it. Every frame whose size depends on its values is then serialized twice,
+    // once to count it.
+    static bool reserve(std::size_t size) { return size <= 64; }
+#endif
+
+    static void write(std::span<std::byte const> data) {
+        for(std::byte const b : data) { dataRegister = b; }
+    }
+};
+
+using Printer = remote_fmt::Printer<RegisterBackend>;
+
+enum class State : std::uint8_t { idle, running, fault };
+
+struct Inputs {
+    std::uint8_t                 channel;
+    std::uint16_t                raw;
+    std::int32_t                 offset;
+    std::uint32_t                tick;
+    float                        voltage;
+    double                       position;
+    bool                         enabled;
+    bool                         overrun;
+    char                         axis;
+    std::string_view             name;
+    std::array<std::uint8_t, 4>  address;
+    std::optional<std::uint16_t> retries;
+    void const*                  buffer;
+};
+
+[[gnu::noinline]] void report(Printer& printer, Inputs const& in) {
+    printer.print("boot"_sc);
+    printer.print("tick {}"_sc, in.tick);
+    printer.print("adc ch{} raw {}"_sc, in.channel, in.raw);
+    printer.print("adc ch{} raw {} offset {}"_sc, in.channel, in.raw, in.offset);
+    printer.print("supply {:.2f} V"_sc, in.voltage);
+    printer.print("axis {} at {:.3f}"_sc, in.axis, in.position);
+    printer.print("axis {} target {:.3f} error {}"_sc, in.axis, in.position, in.offset);
+    printer.print("enabled {} overrun {}"_sc, in.enabled, in.overrun);
+    printer.print("ch{} enabled {} overrun {} tick {}"_sc, in.channel, in.enabled, in.overrun, in.tick);
+    printer.print("task {} started"_sc, in.name);
+    printer.print("task {} took {} ticks"_sc, in.name, in.tick);
+    printer.print("task {} stack {} of {}"_sc, in.name, in.raw, in.offset);
+    printer.print("ip {}"_sc, in.address);
+    printer.print("ip {} port {}"_sc, in.address, in.raw);
+    printer.print("retries {}"_sc, in.retries);
+    printer.print("link {} retries {}"_sc, in.name, in.retries);
+    printer.print("dma buffer {}"_sc, in.buffer);
+    printer.print("dma buffer {} length {}"_sc, in.buffer, in.raw);
+    printer.print("state {}"_sc, static_cast<std::uint8_t>(State::running));
+    printer.print("{:#06x}"_sc, in.raw);
+    printer.print("{:>8} {:<8}"_sc, in.tick, in.offset);
+    printer.print("temp {:.1f} C on ch{}"_sc, in.voltage, in.channel);
+    printer.print("pid p {:.3f} i {:.3f} d {:.3f}"_sc, in.position, in.position, in.position);
+    printer.print("fault {} at tick {} in {}"_sc, in.raw, in.tick, in.name);
+}
+
+}   // namespace
+
+int main() {
+    static std::uint8_t volatile seed{7};
+    std::uint8_t const           value = seed;
+
+    Inputs const inputs{value,
+                        static_cast<std::uint16_t>(value * 300U),
+                        -value,
+                        value * 100000U,
+                        value * 0.5F,
+                        value * 0.25,
+                        (value & 1U) != 0,
+                        (value & 2U) != 0,
+                        'x',
+                        "control",
+                        {192, 168, 0, value},
+                        value,
+                        &inputs};
+
+    Printer printer{};
+    report(printer, inputs);
+    return 0;
+}
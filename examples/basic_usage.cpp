@@ -45,7 +45,7 @@ int main() {
 
     //The remote device parses the data from the buffer without a catalog
     auto const& [message, remainingBytes, discardedBytes]
-      = remote_fmt::parse(std::span{buffer}, {}, [](auto const&) {});
+      = remote_fmt::parse(std::span{buffer}, {}, remote_fmt::NullSink{});
 
     assert(remainingBytes.size() == 0);
     assert(discardedBytes == 0);
@@ -67,7 +67,7 @@ int main() {
 
     //The remote device parses the data from the buffer with a messageCatalog
     auto const& [message, remainingBytes, discardedBytes]
-      = remote_fmt::parse(std::span{buffer}, messageCatalog, [](auto const&) {});
+      = remote_fmt::parse(std::span{buffer}, messageCatalog, remote_fmt::NullSink{});
 
     assert(remainingBytes.size() == 0);
     assert(discardedBytes == 0);
@@ -49,7 +49,7 @@ int main() {
         return 1;
     }
     auto const& [message, remainingBytes, discardedBytes]
-      = remote_fmt::parse(std::span{buffer}, *catalog, [](auto const&) {});
+      = remote_fmt::parse(std::span{buffer}, *catalog, remote_fmt::NullSink{});
 
     assert(remainingBytes.size() == 0);
     assert(discardedBytes == 0);
@@ -0,0 +1,81 @@
+#pragma once
+
+/* Printing from C, or from any code that cannot use StringConstant: the format string and the
+ * argument types arrive at run time, and the frame on the wire is the one Printer::print sends for
+ * the same format string and values.
+ *
+ * One C++ file binds the functions below to a Printer:
+ *
+ *     remote_fmt::Printer<Uart> printer;
+ *     REMOTE_FMT_DEFINE_C_PRINTER(printer)
+ *
+ * and C code calls them:
+ *
+ *     remote_fmt_arg const args[] = {REMOTE_FMT_ARG(REMOTE_FMT_UNSIGNED, channel),
+ *                                    REMOTE_FMT_STRING_ARG(name)};
+ *     remote_fmt_print("channel {} is {}", args, 2);
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The trivial types of the wire format, with their values. */
+enum remote_fmt_type {
+    REMOTE_FMT_UNSIGNED = 0,
+    REMOTE_FMT_SIGNED   = 1,
+    REMOTE_FMT_BOOL     = 2,
+    REMOTE_FMT_CHAR     = 3,
+    REMOTE_FMT_POINTER  = 4,
+    REMOTE_FMT_FLOAT    = 5,
+    /* value is a NUL-terminated string, or NULL for an empty one; size is not used. */
+    REMOTE_FMT_STRING = 16
+};
+
+/* value points to size bytes of the argument, as sizeof gives them: 1, 2, 4 or 8 for the integer
+ * types, 1 for bool and char, 4 or 8 for float, sizeof(uintptr_t) for a pointer. */
+typedef struct remote_fmt_arg {
+    uint8_t     type;
+    uint8_t     size;
+    void const* value;
+} remote_fmt_arg;
+
+#define REMOTE_FMT_ARG(type, lvalue) {(type), sizeof(lvalue), &(lvalue)}
+#define REMOTE_FMT_STRING_ARG(string) {REMOTE_FMT_STRING, 0, (string)}
+
+/* Both return false, and send nothing, for an invalid descriptor. remote_fmt_print also checks the
+ * format string the way print does at compile time - printable characters, one replacement field
+ * per argument and no argument ids - and refuses a number in a spec the host would refuse. A spec
+ * that is wrong for its argument's type is sent anyway; the host reports it. */
+bool remote_fmt_print(char const* fmt, remote_fmt_arg const* args, size_t count);
+
+/* id is a catalog id, see REMOTE_FMT_DEFINE_C_CATALOG_ENTRY. */
+bool remote_fmt_print_cataloged(uint16_t id, remote_fmt_arg const* args, size_t count);
+
+#ifdef __cplusplus
+}
+
+    /* In one C++ file that includes remote_fmt.hpp. printer is a remote_fmt::Printer lvalue, or a
+     * call returning one. */
+    #define REMOTE_FMT_DEFINE_C_PRINTER(printer)                                                \
+        extern "C" bool remote_fmt_print(char const* fmt, remote_fmt_arg const* args,           \
+                                         size_t count) {                                        \
+            return (printer).print_runtime(fmt, std::span<remote_fmt_arg const>{args, count});  \
+        }                                                                                       \
+        extern "C" bool remote_fmt_print_cataloged(uint16_t id, remote_fmt_arg const* args,     \
+                                                   size_t count) {                              \
+            return (printer).print_runtime(id, std::span<remote_fmt_arg const>{args, count});   \
+        }
+
+    /* Puts literal into the catalog of a catalog build and defines uint16_t name(void), which
+     * returns its id for remote_fmt_print_cataloged. Declare name in a header for the C side. */
+    #define REMOTE_FMT_DEFINE_C_CATALOG_ENTRY(name, literal)                                    \
+        extern "C" uint16_t name(void) {                                                        \
+            using namespace sc::literals;                                                       \
+            return remote_fmt::catalog<decltype(literal##_sc)>();                               \
+        }
+#endif
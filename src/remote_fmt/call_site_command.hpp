@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+// Host -> device packets that switch cataloged call sites on and off at run time. Shared by both
+// sides: the host encodes with encodeCallSiteCommand, Printer::apply_call_site_command decodes.
+namespace remote_fmt {
+
+enum class CallSiteCommand : std::uint8_t { disable, enable };
+
+// The ids are the catalog ids of the format strings, as listed in the generated json.
+struct CallSiteRange {
+    CallSiteCommand command;
+    std::uint16_t   first;
+    std::uint16_t   last;
+};
+
+namespace protocol {
+    static constexpr std::byte Call_site_marker{0x5A};
+}   // namespace protocol
+
+// Marker, command, first and last id little endian, and a check byte so that line noise on the
+// receive side cannot switch sites off.
+inline constexpr std::size_t Call_site_command_size{7};
+
+namespace detail {
+    constexpr std::byte callSiteCheck(std::span<std::byte const> bytes) {
+        std::uint8_t sum{};
+        for(std::byte const b : bytes) {
+            sum = static_cast<std::uint8_t>(sum + std::to_integer<std::uint8_t>(b));
+        }
+        return static_cast<std::byte>(~sum);
+    }
+}   // namespace detail
+
+constexpr std::array<std::byte,
+                     Call_site_command_size>
+encodeCallSiteCommand(CallSiteRange const& range) {
+    std::array<std::byte, Call_site_command_size> packet{
+      protocol::Call_site_marker,
+      static_cast<std::byte>(range.command),
+      static_cast<std::byte>(range.first & 0xFFU),
+      static_cast<std::byte>(range.first >> 8U),
+      static_cast<std::byte>(range.last & 0xFFU),
+      static_cast<std::byte>(range.last >> 8U),
+      std::byte{}};
+    packet.back() = detail::callSiteCheck(std::span{packet}.first(Call_site_command_size - 1));
+    return packet;
+}
+
+constexpr std::optional<CallSiteRange> decodeCallSiteCommand(std::span<std::byte const> packet) {
+    if(packet.size() != Call_site_command_size || packet[0] != protocol::Call_site_marker
+       || packet.back() != detail::callSiteCheck(packet.first(Call_site_command_size - 1)))
+    {
+        return std::nullopt;
+    }
+
+    auto const command = std::to_integer<std::uint8_t>(packet[1]);
+    if(command > static_cast<std::uint8_t>(CallSiteCommand::enable)) { return std::nullopt; }
+
+    auto const id = [&](std::size_t offset) {
+        return static_cast<std::uint16_t>(
+          std::to_integer<std::uint16_t>(packet[offset])
+          | (std::to_integer<std::uint16_t>(packet[offset + 1]) << 8U));
+    };
+
+    CallSiteRange const range{static_cast<CallSiteCommand>(command), id(2), id(4)};
+    if(range.first > range.last) { return std::nullopt; }
+    return range;
+}
+
+}   // namespace remote_fmt
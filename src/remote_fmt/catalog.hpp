@@ -4,4 +4,9 @@
 namespace remote_fmt {
 template<typename CFS>
 std::uint16_t catalog();
+
+// Key for the name table of one enum: Names is a StringConstant of all enumerator names, comma
+// separated. catalog<EnumNames<Names>>() returns the id of the first name; the others follow it.
+template<typename Names>
+struct EnumNames;
 }   // namespace remote_fmt
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace remote_fmt {
+
+// ComBackend for a transport that sends from memory on its own, typically a UART with DMA.
+// Frames are copied into one of Buffers buffers of BufferSize bytes while the others are in
+// flight, so print costs the copy and never waits for the wire.
+//
+// Driver does the hardware part:
+//   kick(std::span<std::byte const>)  starts sending a buffer, static or member.
+// and the completion interrupt calls on_complete() on the backend, reachable as
+// printer.get_com_backend(). kick is called from print and from on_complete; one transfer is in
+// flight at a time. Buffers are sent in order, and a frame may span two of them.
+//
+// One context prints, one completes. Meant for a Printer instance: the buffers are members, and
+// staticPrint needs a static write.
+template<typename Driver,
+         std::size_t BufferSize,
+         std::size_t Buffers = 2>
+class DmaBackend {
+    static_assert(Buffers >= 2, "one buffer to fill and at least one in flight");
+    static_assert(BufferSize != 0);
+
+public:
+    constexpr DmaBackend() = default;
+
+    Driver& driver() { return driver_; }
+
+    // A frame goes out as a whole or not at all, see Printer. Room is what the fill buffer has left
+    // plus every buffer that is neither queued nor in flight.
+    bool reserve(std::size_t size) const {
+        std::size_t const filled = fillLength.load();
+        std::size_t const busy   = queued.load();
+        return size <= (BufferSize - filled) + ((Buffers - 1 - busy) * BufferSize);
+    }
+
+    // Waits only if the completion interrupt is handing the fill buffer to the driver right now,
+    // which takes a few instructions.
+    void initTransfer() {
+        Owner expected = Owner::none;
+        while(!fillOwner.compare_exchange_weak(expected, Owner::writer)) {
+            expected = Owner::none;
+        }
+    }
+
+    void write(std::span<std::byte const> data) {
+        while(!data.empty()) {
+            std::size_t const filled = fillLength.load(std::memory_order_relaxed);
+            if(filled == BufferSize && !commit()) {
+                // No reservation covers this; what does not fit is lost.
+                return;
+            }
+            std::size_t const used  = fillLength.load(std::memory_order_relaxed);
+            std::size_t const chunk = std::min(data.size(), BufferSize - used);
+            std::memcpy(buffers[fillIndex].data() + used, data.data(), chunk);
+            fillLength.store(used + chunk, std::memory_order_relaxed);
+            data = data.subspan(chunk);
+        }
+    }
+
+    // An idle transport gets the frame at once. A busy one gets it with whatever else arrives
+    // before the transfer in flight completes.
+    void finalizeTransfer() {
+        if(queued.load() == 0) { commit(); }
+        fillOwner.store(Owner::none);
+
+        // The transfer may have completed after the check above but before the release, while the
+        // interrupt could not take the buffer.
+        takeFillIfIdle();
+    }
+
+    // Call from the transfer-complete interrupt.
+    void on_complete() {
+        sendIndex = next(sendIndex);
+        if(queued.fetch_sub(1) > 1) {
+            kick(buffers[sendIndex].data(), lengths[sendIndex]);
+            return;
+        }
+        takeFillIfIdle();
+    }
+
+    // Nothing queued, in flight or waiting in the fill buffer.
+    bool idle() const { return queued.load() == 0 && fillLength.load() == 0; }
+
+private:
+    enum class Owner : std::uint8_t { none, writer, interrupt };
+
+    static constexpr std::size_t next(std::size_t index) { return (index + 1) % Buffers; }
+
+    void kick(std::byte const* data,
+              std::size_t      size) {
+        if constexpr(requires { Driver::kick(std::span<std::byte const>{}); }) {
+            Driver::kick(std::span<std::byte const>{data, size});
+        } else {
+            driver_.kick(std::span<std::byte const>{data, size});
+        }
+    }
+
+    // Hands the fill buffer over and moves on to the next one. The caller owns the fill buffer.
+    // The driver is started when nothing was in flight.
+    bool commit() {
+        std::size_t const filled = fillLength.load(std::memory_order_relaxed);
+        if(filled == 0) { return true; }
+        if(queued.load() == Buffers - 1) { return false; }
+
+        std::size_t const index = fillIndex;
+        lengths[index]          = filled;
+        fillIndex               = next(index);
+        // Queued before the fill buffer reads empty, so reserve never counts this buffer twice.
+        bool const wasIdle = queued.fetch_add(1) == 0;
+        fillLength.store(0);
+        if(wasIdle) { kick(buffers[index].data(), filled); }
+        return true;
+    }
+
+    void takeFillIfIdle() {
+        if(queued.load() != 0 || fillLength.load() == 0) { return; }
+        Owner expected = Owner::none;
+        if(!fillOwner.compare_exchange_strong(expected, Owner::interrupt)) { return; }
+        commit();
+        fillOwner.store(Owner::none);
+    }
+
+    [[no_unique_address]] Driver driver_{};
+
+    std::array<std::array<std::byte, BufferSize>, Buffers> buffers{};
+    std::array<std::size_t, Buffers>                       lengths{};
+
+    // The ring: sendIndex is in flight, followed by the rest of the queued buffers, then fillIndex.
+    std::size_t sendIndex{};
+    std::size_t fillIndex{};
+
+    std::atomic<std::size_t> queued{};
+    std::atomic<std::size_t> fillLength{};
+    std::atomic<Owner>       fillOwner{Owner::none};
+};
+
+}   // namespace remote_fmt
@@ -5,8 +5,14 @@
 #include "remote_fmt/type_identifier.hpp"
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #ifdef __GNUC__
     #pragma GCC diagnostic push
@@ -27,11 +33,12 @@
 #ifdef __clang__
     #pragma clang diagnostic pop
 #endif
-#include <functional>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <optional>
 #include <ratio>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -41,6 +48,89 @@
 #include <vector>
 
 namespace remote_fmt {
+
+// Values nested deeper than this - optionals, tuples, ranges, sub format strings, in any mix - fail
+// the frame before their identifier is read, which bounds the stack and the strings a hostile or
+// corrupted stream can make the parser build.
+#ifndef REMOTE_FMT_MAX_PARSE_DEPTH
+static constexpr std::size_t max_parse_depth = 32;
+#else
+static constexpr std::size_t max_parse_depth{REMOTE_FMT_MAX_PARSE_DEPTH};
+#endif
+
+// What a message passed to the error callback is about.
+enum class ParseError : std::uint8_t {
+    // fmt rejected a replacement field for the value it was given.
+    format,
+    // A time value too large for fmt's chrono formatting.
+    time_out_of_range,
+    // A cataloged string or format string whose id is not in the catalog.
+    catalog_miss,
+    // A dynamic spec, or a number in a spec above Max_replacement_field_number.
+    unsupported_field,
+    // The device reported frames it dropped before this one.
+    device_drop,
+    // A value nested deeper than max_parse_depth.
+    too_deep
+};
+
+// The parts parseFrame spends its time in, for a Stats that asks for stage times.
+enum class ParseStage : std::uint8_t {
+    // Looking for the start of the next frame and for its end.
+    resync,
+    // Walking the bytes of a frame, without the formatting of its values.
+    decode,
+    // Formatting values with fmt.
+    format
+};
+
+// What the bytes of a capture are spent on.
+enum class WireCategory : std::uint8_t {
+    // Start and end markers, and the drop reports in front of a frame.
+    framing,
+    // Type identifiers, and the schemas and enum tables a compact range sends once for all of
+    // its elements.
+    type_identifier,
+    // Element counts and string lengths.
+    size,
+    // Ids standing in for cataloged format strings, strings, schemas and enum names.
+    catalog_id,
+    // Format strings sent as text, which a catalog build replaces with an id.
+    format_string,
+    // The values themselves.
+    payload
+};
+
+// Told by the parser what the bytes it reads are spent on, for analyzeWire in wire_report.hpp.
+// The parser's default, which ignores it all. Of an element of a compact range only the payload is
+// told; the schema all elements share is told once, as the parser reads it.
+struct NoWireTally {
+    // A complete frame is about to be decoded.
+    void frame() {}
+    // A format string, by catalog id or by text. The first after frame is the frame's own.
+    void fmtString(std::optional<std::uint16_t> /*id*/,
+                   std::string_view /*text*/) {}
+    // An argument of a format string starts with identifier and holds that many values, more
+    // than one for a group of bools. Those of a nested format string enter within their carrier.
+    void enterArgument(std::byte /*identifier*/,
+                       std::size_t /*values*/) {}
+    void leaveArgument() {}
+    void bytes(WireCategory /*category*/,
+               std::size_t /*bytes*/) {}
+    // Bytes of trivial values, or of their identifier, and how many values were read.
+    void trivial(detail::TrivialType /*trivialType*/,
+                 WireCategory /*category*/,
+                 std::size_t /*bytes*/,
+                 std::size_t /*values*/) {}
+};
+
+// An error callback that takes nothing. Passed to parse in place of a callback, no error message
+// is ever built. A callback deriving from it is called with the ParseError of each error, and
+// gets no message either.
+struct NullSink {
+    void operator()(ParseError /*error*/) const {}
+};
+
 namespace detail {
 
     template<typename Iterator>
@@ -52,13 +142,33 @@ namespace detail {
     template<typename Iterator>
     using ParseResult = std::optional<ParseResult_<Iterator>>;
 
+    // Text that is used as it is, a view into the buffer being parsed or into the catalog.
+    template<typename Iterator>
+    struct TextResult_ {
+        std::string_view str;
+        Iterator         pos;
+    };
+
+    template<typename Iterator>
+    using TextResult = std::optional<TextResult_<Iterator>>;
+
+    // The bytes from first to last as text, without copying them. Iterator is contiguous, as the
+    // iterators of the std::span<std::byte const> every parse entry point takes are.
+    template<typename Iterator>
+    std::string_view asText(Iterator first,
+                            Iterator last) {
+        if(first == last) { return {}; }
+        return {reinterpret_cast<char const*>(std::to_address(first)),
+                static_cast<std::size_t>(std::distance(first, last))};
+    }
+
     template<ExtendedTypeIdentifier>
     struct ExtendedTypeIdentifierParser;
 
     template<>
     struct ExtendedTypeIdentifierParser<ExtendedTypeIdentifier::styled> {
         // NOTE: This function is part of a recursive parsing system for nested data structures.
-        // Recursion is bounded by the structure of the serialized data being parsed.
+        // Recursion is bounded by max_parse_depth, see Parser::parseFromTypeId.
         template<typename Iterator,
                  typename Parser>
         static ParseResult<Iterator>
@@ -71,7 +181,8 @@ namespace detail {
                                  std::string> const& stringConstantsMap,
               Parser&                                parser) {
             if(1 > static_cast<std::size_t>(std::distance(first, last))) { return std::nullopt; }
-            std::uint8_t const set = static_cast<std::uint8_t>(*first);
+            auto const         styleFirst = first;
+            std::uint8_t const set        = static_cast<std::uint8_t>(*first);
             ++first;
 
             if((set & static_cast<std::uint8_t>(0xC0)) != 0) { return std::nullopt; }
@@ -128,6 +239,8 @@ namespace detail {
                 ++first;
                 style |= fmt::text_style{static_cast<fmt::emphasis>(emp_value)};
             }
+            parser.tallyBytes(WireCategory::payload,
+                              static_cast<std::size_t>(std::distance(styleFirst, first)));
 
             auto const inner_result = parser.parseFromTypeId(first,
                                                              last,
@@ -150,7 +263,7 @@ namespace detail {
     template<>
     struct ExtendedTypeIdentifierParser<ExtendedTypeIdentifier::optional> {
         // NOTE: This function is part of a recursive parsing system for optional value types.
-        // Recursion is bounded by the structure of the serialized data being parsed.
+        // Recursion is bounded by max_parse_depth, see Parser::parseFromTypeId.
         template<typename Iterator,
                  typename Parser>
         static ParseResult<Iterator>
@@ -167,6 +280,7 @@ namespace detail {
             ++first;
 
             if(isSet != 0 && isSet != 1) { return std::nullopt; }
+            parser.tallyBytes(WireCategory::payload, 1);
 
             if(isSet == 0) { return ParseResult_<Iterator>{"none", first}; }
             // in_list is forced true rather than forwarded: a wrapper payload is a nested position,
@@ -228,6 +342,7 @@ namespace detail {
             ++first;
 
             if(hasValue != 0 && hasValue != 1) { return std::nullopt; }
+            parser.tallyBytes(WireCategory::payload, 1);
 
             // in_list forced true for the same reason as optional: fmt writes expected("ok") and
             // unexpected("err"), keeping the debug format inside the wrapper.
@@ -268,14 +383,430 @@ namespace detail {
         }
     };
 
+    template<>
+    struct ExtendedTypeIdentifierParser<ExtendedTypeIdentifier::repeated> {
+        // The notice stands in for a whole message, so only a bare "{}" may hold it. The format
+        // string is shown unformatted: the held-back frames' arguments never reached the host.
+        template<typename Iterator,
+                 typename Parser>
+        static ParseResult<Iterator>
+        parse(Iterator         first,
+              Iterator         last,
+              std::string_view replacementField,
+              bool             in_map,
+              bool             in_list,
+              std::unordered_map<std::uint16_t,
+                                 std::string> const& stringConstantsMap,
+              Parser&                                parser) {
+            if(replacementField != "{}" || in_map || in_list) { return std::nullopt; }
+
+            auto const optionalCount = parser.extractSize(first, last, TypeSize::_4);
+            if(!optionalCount || optionalCount->first == 0) { return std::nullopt; }
+            first = optionalCount->second;
+            parser.tallyBytes(WireCategory::payload, 4);
+
+            if(first == last) { return std::nullopt; }
+            FmtStringType const type = parseFmtStringTypeIdentifier(*first, FmtStringType::normal)
+                                       ? FmtStringType::normal
+                                       : FmtStringType::cataloged_normal;
+            if(!parseFmtStringTypeIdentifier(*first, type)) { return std::nullopt; }
+
+            // Also takes over the level of the held-back message.
+            auto const fmtString = parser.parseFmtString(first, last, type, stringConstantsMap);
+            if(!fmtString) { return std::nullopt; }
+            return ParseResult_<Iterator>{
+              fmt::format("{:?} repeated {} {}",
+                          fmtString->str,
+                          optionalCount->first,
+                          optionalCount->first == 1 ? "time" : "times"),
+              fmtString->pos};
+        }
+    };
+
+    template<>
+    struct ExtendedTypeIdentifierParser<ExtendedTypeIdentifier::aggregate> {
+        template<typename Iterator,
+                 typename Parser>
+        static ParseResult<Iterator>
+        parse(Iterator         first,
+              Iterator         last,
+              std::string_view replacementField,
+              bool             in_map,
+              bool /*in_list*/,
+              std::unordered_map<std::uint16_t,
+                                 std::string> const& stringConstantsMap,
+              Parser&                                parser) {
+            if(first == last) { return std::nullopt; }
+            auto const rangeTypeId = parseRangeTypeIdentifier(*first);
+            if(!rangeTypeId
+               || (std::get<0>(*rangeTypeId) != RangeType::string
+                   && std::get<0>(*rangeTypeId) != RangeType::cataloged_string))
+            {
+                return std::nullopt;
+            }
+
+            auto const schema = parser.parseSchemaText(first, last, stringConstantsMap);
+            if(!schema) { return std::nullopt; }
+            return parser.parseAggregate(schema->pos, last, schema->str, replacementField, in_map);
+        }
+    };
+
+    template<>
+    struct ExtendedTypeIdentifierParser<ExtendedTypeIdentifier::enumeration> {
+        template<typename Iterator,
+                 typename Parser>
+        static ParseResult<Iterator>
+        parse(Iterator         first,
+              Iterator         last,
+              std::string_view replacementField,
+              bool /*in_map*/,
+              bool                                   in_list,
+              std::unordered_map<std::uint16_t,
+                                 std::string> const& stringConstantsMap,
+              Parser&                                parser) {
+            if(first == last) { return std::nullopt; }
+            auto const indexTypeId = parseTrivialTypeIdentifier(*first);
+            if(!indexTypeId
+               || (indexTypeId->first != TrivialType::unsigned_
+                   && indexTypeId->first != TrivialType::signed_))
+            {
+                return std::nullopt;
+            }
+            auto const [indexType, indexSize] = *indexTypeId;
+
+            auto const count = parser.extractSize(std::next(first), last, TypeSize::_2);
+            if(!count || count->second == last) { return std::nullopt; }
+            first = count->second;
+            parser.tallyBytes(WireCategory::type_identifier, 1);
+            parser.tallyBytes(WireCategory::size, 2);
+
+            // The table is the catalog id of its first name, or the names themselves.
+            auto const tableTypeId = parseRangeTypeIdentifier(*first);
+            if(!tableTypeId) { return std::nullopt; }
+            auto const [tableType, tableSize, tableLayout] = *tableTypeId;
+            std::size_t                tableId = 0;
+            std::optional<std::string> names;
+            if(tableType == RangeType::cataloged_string && tableLayout == RangeLayout::compact) {
+                auto const id
+                  = parser.extractSize(std::next(first), last, rangeSizeToTypeSize(tableSize));
+                if(!id) { return std::nullopt; }
+                tableId = id->first;
+                first   = id->second;
+                parser.tallyBytes(WireCategory::type_identifier, 1);
+                parser.tallyBytes(WireCategory::catalog_id, byteSize(tableSize));
+            } else if(tableType == RangeType::string) {
+                auto const joined = parser.parseSchemaText(first, last, stringConstantsMap);
+                if(!joined) { return std::nullopt; }
+                names = joined->str;
+                first = joined->pos;
+            } else {
+                return std::nullopt;
+            }
+
+            if(byteSize(indexSize) > static_cast<std::size_t>(std::distance(first, last))) {
+                return std::nullopt;
+            }
+            auto const index = [&]() -> std::optional<std::size_t> {
+                if(indexType == TrivialType::unsigned_) {
+                    auto const value = parser.extractUnsigned(first, last, indexSize);
+                    if(!value || *value >= count->first) { return std::nullopt; }
+                    return static_cast<std::size_t>(*value);
+                }
+                auto const value = parser.extractSigned(first, last, indexSize);
+                if(!value || *value < 0 || static_cast<std::uint64_t>(*value) >= count->first) {
+                    return std::nullopt;
+                }
+                return static_cast<std::size_t>(*value);
+            }();
+            if(!index) {
+                return parser.extractAndFormatTrivial(first,
+                                                      last,
+                                                      replacementField,
+                                                      indexType,
+                                                      indexSize,
+                                                      in_list);
+            }
+            parser.tallyTrivial(indexType, WireCategory::payload, byteSize(indexSize), 1);
+            auto const valueLast
+              = std::next(first, static_cast<std::make_signed_t<std::size_t>>(byteSize(indexSize)));
+
+            if(!names) {
+                if(tableId + *index > std::numeric_limits<std::uint16_t>::max()) {
+                    return std::nullopt;
+                }
+                return parser.parseCatalogedString(valueLast,
+                                                   last,
+                                                   tableId + *index,
+                                                   RangeLayout::compact,
+                                                   replacementField,
+                                                   in_list,
+                                                   stringConstantsMap);
+            }
+
+            std::string_view name{*names};
+            for(std::size_t skip = *index; skip != 0; --skip) {
+                auto const comma = name.find(',');
+                if(comma == std::string_view::npos) { return std::nullopt; }
+                name = name.substr(comma + 1);
+            }
+            name = name.substr(0, name.find(','));
+            auto const timer = parser.formatTimer();
+            try {
+                if(in_list && replacementField == Default_replacement_field) {
+                    return {
+                      {fmt::format("{:?}", name), valueLast}
+                    };
+                }
+                return {
+                  {fmt::format(fmt::runtime(replacementField), name), valueLast}
+                };
+            } catch(std::exception const& e) {
+                parser.error(ParseError::format,
+                             "bad format for replacement field {:?}: {} (enumerator: \"{}\")",
+                             replacementField,
+                             e.what(),
+                             name);
+                return std::nullopt;
+            }
+        }
+    };
+
+    // A replacement field an integer is formatted for without fmt: "{}", and the hex specs with
+    // an optional '#' and zero padding, "{:x}", "{:#x}", "{:08X}", "{:#010x}".
+    struct IntegerSpec {
+        int         base{10};
+        bool        upper{};
+        bool        alternate{};
+        // Zero padded to this width, sign and prefix included.
+        std::size_t width{};
+    };
+
+    constexpr std::optional<IntegerSpec> simpleIntegerSpec(TrivialType      trivialType,
+                                                           std::string_view replacementField) {
+        if(trivialType != TrivialType::unsigned_ && trivialType != TrivialType::signed_) {
+            return std::nullopt;
+        }
+        if(replacementField == Default_replacement_field) { return IntegerSpec{}; }
+        if(replacementField.size() < 4 || !replacementField.starts_with("{:")
+           || (!replacementField.ends_with("x}") && !replacementField.ends_with("X}")))
+        {
+            return std::nullopt;
+        }
+
+        IntegerSpec spec{16, replacementField[replacementField.size() - 2] == 'X'};
+        std::string_view flags = replacementField.substr(2, replacementField.size() - 4);
+        if(flags.starts_with('#')) {
+            spec.alternate = true;
+            flags.remove_prefix(1);
+        }
+        if(flags.empty()) { return spec; }
+        // '0' and a width of one or two digits; anything else is left to fmt.
+        if(flags.size() < 2 || flags.size() > 3 || flags[0] != '0' || flags[1] == '0') {
+            return std::nullopt;
+        }
+        for(char const digit : flags.substr(1)) {
+            if(digit < '0' || digit > '9') { return std::nullopt; }
+            spec.width = (spec.width * 10) + static_cast<std::size_t>(digit - '0');
+        }
+        return spec;
+    }
+
+    // Appends value the way fmt formats it with spec.
+    template<std::integral T>
+    void appendInteger(std::string&       out,
+                       T                  value,
+                       IntegerSpec const& spec) {
+        using Unsigned = std::make_unsigned_t<T>;
+        bool negative{};
+        auto magnitude = static_cast<Unsigned>(value);
+        if constexpr(std::is_signed_v<T>) {
+            negative = value < 0;
+            if(negative) { magnitude = static_cast<Unsigned>(Unsigned{} - magnitude); }
+        }
+
+        std::array<char, std::numeric_limits<Unsigned>::digits10 + 1> digits{};
+        std::array<char, 2 * sizeof(T)>                                hexDigits{};
+        std::span<char> const buffer = spec.base == 10 ? std::span<char>{digits} : hexDigits;
+        auto const digitsEnd
+          = std::to_chars(buffer.data(), buffer.data() + buffer.size(), magnitude, spec.base).ptr;
+        auto const count = static_cast<std::size_t>(digitsEnd - buffer.data());
+        if(spec.upper) {
+            std::transform(buffer.data(), digitsEnd, buffer.data(), [](char digit) {
+                return digit >= 'a' ? static_cast<char>(digit - 'a' + 'A') : digit;
+            });
+        }
+
+        std::size_t const prefix = (negative ? 1U : 0U) + (spec.alternate ? 2U : 0U);
+        if(negative) { out += '-'; }
+        if(spec.alternate) { out += spec.upper ? "0X" : "0x"; }
+        if(spec.width > prefix + count) { out.append(spec.width - prefix - count, '0'); }
+        out.append(buffer.data(), count);
+    }
+
+    // The precision of "{:.2f}" and the like, one or two digits: a float formatted without fmt.
+    constexpr std::optional<int> fixedPrecision(std::string_view replacementField) {
+        if(replacementField.size() < 6 || replacementField.size() > 7
+           || !replacementField.starts_with("{:.") || !replacementField.ends_with("f}"))
+        {
+            return std::nullopt;
+        }
+        int precision{};
+        for(char const digit : replacementField.substr(3, replacementField.size() - 5)) {
+            if(digit < '0' || digit > '9') { return std::nullopt; }
+            precision = (precision * 10) + (digit - '0');
+        }
+        return precision;
+    }
+
+    // Appends value the way fmt formats it with "{:.<precision>f}". Both round the exact binary
+    // value, so they agree digit for digit. False, with nothing appended, for what is left to fmt:
+    // nan, inf and values too long for the buffer.
+    template<std::floating_point T>
+    bool appendFixed(std::string& out,
+                     T            value,
+                     int          precision) {
+        if(!std::isfinite(value)) { return false; }
+        std::array<char, 64> buffer{};
+        auto const [end, error] = std::to_chars(buffer.data(),
+                                                buffer.data() + buffer.size(),
+                                                value,
+                                                std::chars_format::fixed,
+                                                precision);
+        if(error != std::errc{}) { return false; }
+        out.append(buffer.data(), end);
+        return true;
+    }
+
+    // The payload of a compact range of integers, size elements of T from data, each formatted
+    // with spec and separated as range elements are. One load per element, no intermediate
+    // strings.
+    template<std::integral T>
+    void appendIntegers(std::string&       out,
+                        std::byte const*   data,
+                        std::size_t        size,
+                        IntegerSpec const& spec) {
+        for(std::size_t index = 0; index != size; ++index) {
+            T value;
+            std::memcpy(&value, data + (index * sizeof(T)), sizeof(T));
+            if(index != 0) { out += ", "; }
+            appendInteger(out, value, spec);
+        }
+    }
+
+    // Calls an error callback with or without the ParseError argument.
+    template<typename ErrorMessageF>
+    void reportError(ErrorMessageF&   errorMessagef,
+                     ParseError       error,
+                     std::string_view message) {
+        if constexpr(std::is_invocable_v<ErrorMessageF&, ParseError, std::string_view>) {
+            errorMessagef(error, message);
+        } else {
+            errorMessagef(message);
+        }
+    }
+
+    template<typename Sink>
+    constexpr bool takes_messages = !std::is_base_of_v<NullSink, std::remove_cvref_t<Sink>>;
+
+    // Holds nothing from one frame to the next, so one Parser can decode any number of frames.
+    template<typename Sink,
+             typename Tally = NoWireTally>
     struct Parser {
-        std::function<void(std::string_view)> errorMessagef;
+        // An error callback as parse takes it, or a NullSink.
+        Sink sink;
+        // Told what the bytes are spent on as they are read.
+        [[no_unique_address]] Tally tally;
+        // Set by the top-level format string of a leveled print.
+        std::optional<Level> level;
+        // Where the time spent in fmt goes, when the caller asked for stage times.
+        std::chrono::nanoseconds* formatTime{};
+        // Levels of parseFromTypeId currently entered.
+        std::size_t depth{};
+        // Reading the text of a schema, which is spent on types rather than values.
+        bool inSchemaText{};
+        // Reading an element put back together from a compact range's schema, whose payload is
+        // all that was sent for it.
+        bool inElement{};
+
+        explicit Parser(Sink  sink_,
+                        Tally tally_ = {})
+          : sink{std::move(sink_)}
+          , tally{std::move(tally_)} {}
+
+        // The message is only built for a sink that takes it.
+        template<typename... Args>
+        void error(ParseError                  category,
+                   fmt::format_string<Args...> message,
+                   Args&&... args) {
+            if constexpr(takes_messages<Sink>) {
+                reportError(sink, category, fmt::format(message, std::forward<Args>(args)...));
+            } else {
+                sink(category);
+            }
+        }
+
+        // Adds the time until it goes out of scope to formatTime, if set.
+        class FormatTimer {
+        public:
+            explicit FormatTimer(std::chrono::nanoseconds* total_)
+              : total{total_}
+              , start{total_ == nullptr ? std::chrono::steady_clock::time_point{}
+                                        : std::chrono::steady_clock::now()} {}
+
+            FormatTimer(FormatTimer const&)            = delete;
+            FormatTimer& operator=(FormatTimer const&) = delete;
+
+            ~FormatTimer() {
+                if(total != nullptr) { *total += std::chrono::steady_clock::now() - start; }
+            }
+
+        private:
+            std::chrono::nanoseconds*             total;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        FormatTimer formatTimer() const { return FormatTimer{formatTime}; }
+
+        void tallyBytes(WireCategory category,
+                        std::size_t  bytes) {
+            if(inSchemaText && category == WireCategory::payload) {
+                category = WireCategory::type_identifier;
+            }
+            if(inElement && category != WireCategory::payload) { return; }
+            tally.bytes(category, bytes);
+        }
+
+        void tallyTrivial(TrivialType  trivialType,
+                          WireCategory category,
+                          std::size_t  bytes,
+                          std::size_t  values) {
+            if(inElement && category != WireCategory::payload) { return; }
+            tally.trivial(trivialType, category, bytes, values);
+        }
+
+        // Goes one level deeper, unless that is past max_parse_depth.
+        bool enterLevel() {
+            if(depth == max_parse_depth) {
+                error(ParseError::too_deep, "value nested deeper than {} levels", max_parse_depth);
+                return false;
+            }
+            ++depth;
+            return true;
+        }
+
+        // Leaves the level enterLevel went into when it goes out of scope.
+        class LevelExit {
+        public:
+            explicit LevelExit(std::size_t& depth_) : depth{depth_} {}
+
+            LevelExit(LevelExit const&)            = delete;
+            LevelExit& operator=(LevelExit const&) = delete;
 
-        template<typename ErrorMessageF>
-            requires(!std::is_same_v<std::decay_t<ErrorMessageF>,
-                                     Parser>)
-        explicit Parser(ErrorMessageF&& errorMessagef_)
-          : errorMessagef{std::forward<ErrorMessageF>(errorMessagef_)} {}
+            ~LevelExit() { --depth; }
+
+        private:
+            std::size_t& depth;
+        };
 
         std::optional<std::string_view>
         getNextReplacementFieldFromFmtStringAndAppendStrings(std::string&      out,
@@ -454,18 +985,31 @@ namespace detail {
             };
         }
 
-        template<typename Iterator>
-        ParseResult<Iterator> extractAndFormatTrivial(Iterator         first,
-                                                      Iterator         last,
-                                                      std::string_view replacementField,
-                                                      TrivialType      trivialType,
-                                                      TypeSize         typeSize,
-                                                      bool             in_list) {
-            auto const optionalTrivial = extractTrivial(first, last, trivialType, typeSize);
-            if(!optionalTrivial) { return std::nullopt; }
-            first                  = optionalTrivial->second;
-            auto const optionalStr = std::visit(
+        std::optional<std::string> formatTrivial(trivial_t const& trivial,
+                                                 std::string_view replacementField,
+                                                 TrivialType      trivialType,
+                                                 TypeSize         typeSize,
+                                                 bool             in_list) {
+            return std::visit(
               [&](auto const& value) -> std::optional<std::string> {
+                  using Value      = std::remove_cvref_t<decltype(value)>;
+                  auto const timer = formatTimer();
+                  // "{}" and the plain hex and fixed specs are written directly; fmt gets the
+                  // rest, and whatever the direct writers leave to it.
+                  if constexpr(std::is_same_v<Value, std::uint64_t>
+                               || std::is_same_v<Value, std::int64_t>)
+                  {
+                      if(auto const spec = simpleIntegerSpec(trivialType, replacementField)) {
+                          std::string out;
+                          appendInteger(out, value, *spec);
+                          return out;
+                      }
+                  } else if constexpr(std::is_floating_point_v<Value>) {
+                      if(auto const precision = fixedPrecision(replacementField)) {
+                          std::string out;
+                          if(appendFixed(out, value, *precision)) { return out; }
+                      }
+                  }
                   try {
                       // A char nested in a range or tuple gets fmt's debug format ('x', with
                       // control bytes escaped), matching what fmt does for the same container.
@@ -477,22 +1021,77 @@ namespace detail {
                       }
                       return fmt::format(fmt::runtime(replacementField), value);
                   } catch(std::exception const& e) {
-                      errorMessagef(fmt::format(
-                        "bad format for replacement field {:?}: {} (type: {}, size: {} bytes)",
-                        replacementField,
-                        e.what(),
-                        enchantum::to_string(trivialType),
-                        byteSize(typeSize)));
+                      error(ParseError::format,
+                            "bad format for replacement field {:?}: {} (type: {}, size: {} bytes)",
+                            replacementField,
+                            e.what(),
+                            enchantum::to_string(trivialType),
+                            byteSize(typeSize));
                       return std::nullopt;
                   }
               },
-              optionalTrivial->first);
+              trivial);
+        }
+
+        template<typename Iterator>
+        ParseResult<Iterator> extractAndFormatTrivial(Iterator         first,
+                                                      Iterator         last,
+                                                      std::string_view replacementField,
+                                                      TrivialType      trivialType,
+                                                      TypeSize         typeSize,
+                                                      bool             in_list) {
+            auto const optionalTrivial = extractTrivial(first, last, trivialType, typeSize);
+            if(!optionalTrivial) { return std::nullopt; }
+            first = optionalTrivial->second;
+            tallyTrivial(trivialType, WireCategory::payload, byteSize(typeSize), 1);
+            auto const optionalStr
+              = formatTrivial(optionalTrivial->first, replacementField, trivialType, typeSize, in_list);
             if(!optionalStr) { return std::nullopt; }
             return {
               {*optionalStr, first}
             };
         }
 
+        // The elements of a compact integer range for which simpleIntegerSpec holds, all at once.
+        // Nothing if the payload is cut short.
+        template<typename Iterator>
+        std::optional<Iterator> appendIntegerRange(std::string&       out,
+                                                   Iterator           first,
+                                                   Iterator           last,
+                                                   std::size_t        size,
+                                                   TrivialType        trivialType,
+                                                   TypeSize           typeSize,
+                                                   IntegerSpec const& spec) {
+            auto const byteCount = byteSize(typeSize);
+            if(size > static_cast<std::size_t>(std::distance(first, last)) / byteCount) {
+                return std::nullopt;
+            }
+            auto const timer = formatTimer();
+            out.reserve(out.size() + (size * (std::max(spec.width, (3 * byteCount) + 3) + 2)));
+            std::byte const* const data   = std::to_address(first);
+            bool const             signed_ = trivialType == TrivialType::signed_;
+            switch(typeSize) {
+            case TypeSize::_1:
+                signed_ ? appendIntegers<std::int8_t>(out, data, size, spec)
+                        : appendIntegers<std::uint8_t>(out, data, size, spec);
+                break;
+            case TypeSize::_2:
+                signed_ ? appendIntegers<std::int16_t>(out, data, size, spec)
+                        : appendIntegers<std::uint16_t>(out, data, size, spec);
+                break;
+            case TypeSize::_4:
+                signed_ ? appendIntegers<std::int32_t>(out, data, size, spec)
+                        : appendIntegers<std::uint32_t>(out, data, size, spec);
+                break;
+            case TypeSize::_8:
+                signed_ ? appendIntegers<std::int64_t>(out, data, size, spec)
+                        : appendIntegers<std::uint64_t>(out, data, size, spec);
+                break;
+            }
+            tallyTrivial(trivialType, WireCategory::payload, size * byteCount, size);
+            return std::next(first, static_cast<std::make_signed_t<std::size_t>>(size * byteCount));
+        }
+
         template<typename Iterator>
         ParseResult<Iterator> parseTrivial(Iterator         first,
                                            Iterator         last,
@@ -503,6 +1102,7 @@ namespace detail {
             if(!trivialTypeId) { return std::nullopt; }
             ++first;
             auto const [trivialType, typeSize] = *trivialTypeId;
+            tallyTrivial(trivialType, WireCategory::type_identifier, 1, 0);
             return extractAndFormatTrivial(first,
                                            last,
                                            replacementField,
@@ -511,54 +1111,27 @@ namespace detail {
                                            in_list);
         }
 
-        using std_ratios = std::tuple<std::atto,
-                                      std::femto,
-                                      std::pico,
-                                      std::nano,
-                                      std::micro,
-                                      std::milli,
-                                      std::centi,
-                                      std::ratio<1>,
-                                      std::deci,
-                                      std::deca,
-                                      std::hecto,
-                                      std::kilo,
-                                      std::mega,
-                                      std::giga,
-                                      std::tera,
-                                      std::peta,
-                                      std::exa,
-                                      std::chrono::nanoseconds::period,
-                                      std::chrono::microseconds::period,
-                                      std::chrono::milliseconds::period,
-                                      std::chrono::seconds::period,
-                                      std::chrono::minutes::period,
-                                      std::chrono::hours::period,
-                                      std::chrono::days::period,
-                                      std::chrono::weeks::period,
-                                      std::chrono::months::period,
-                                      std::chrono::years::period>;
-
         template<typename Rep,
                  typename Ratio>
         std::optional<std::string> formatTimeFixedRatioImpl(Rep              value,
                                                             TimeType         timeType,
                                                             std::string_view replacementField) {
-            using duration = std::chrono::duration<Rep, Ratio>;
+            using duration   = std::chrono::duration<Rep, Ratio>;
+            auto const timer = formatTimer();
             try {
                 if(timeType == TimeType::duration) {
                     return fmt::format(fmt::runtime(replacementField), duration{value});
                 }
             } catch(std::exception const& e) {
-                errorMessagef(
-                  fmt::format("bad format for replacement field {:?}: {} (timeType: {}, ratio: "
-                              "{}/{}, value: {})",
-                              replacementField,
-                              e.what(),
-                              enchantum::to_string(timeType),
-                              Ratio::num,
-                              Ratio::den,
-                              value));
+                error(ParseError::format,
+                      "bad format for replacement field {:?}: {} (timeType: {}, ratio: "
+                      "{}/{}, value: {})",
+                      replacementField,
+                      e.what(),
+                      enchantum::to_string(timeType),
+                      Ratio::num,
+                      Ratio::den,
+                      value);
             }
             return std::nullopt;
         }
@@ -583,38 +1156,65 @@ namespace detail {
             double const seconds
               = (static_cast<double>(value) * static_cast<double>(num)) / static_cast<double>(den);
             if(seconds >= -maxSeconds && seconds <= maxSeconds) { return true; }
-            errorMessagef(
-              fmt::format("time value out of range (ratio: {}/{}, value: {})", num, den, value));
+            error(ParseError::time_out_of_range,
+                  "time value out of range (ratio: {}/{}, value: {})",
+                  num,
+                  den,
+                  value);
             return false;
         }
 
+        // numerator/denominator of every std_ratios entry, indexed like the tuple.
+        static constexpr auto std_ratio_table = []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::array<std::pair<std::uint64_t,
+                                        std::uint64_t>,
+                              sizeof...(Is)>{
+              {{static_cast<std::uint64_t>(std::tuple_element_t<Is, std_ratios>::num),
+                static_cast<std::uint64_t>(std::tuple_element_t<Is, std_ratios>::den)}...}
+            };
+        }(std::make_index_sequence<std::tuple_size_v<std_ratios>>{});
+
+        // Only the full encoding needs this; the compact one carries the index itself.
+        static std::optional<std::size_t> findStdRatio(std::uint64_t num,
+                                                       std::uint64_t den) {
+            auto const ratioIt = std::ranges::find(std_ratio_table, std::pair{num, den});
+            if(ratioIt == std_ratio_table.end()) { return std::nullopt; }
+            return static_cast<std::size_t>(std::distance(std_ratio_table.begin(), ratioIt));
+        }
+
         template<typename Rep>
-        std::optional<std::string> formatTimeImpl(std::uint64_t    num,
-                                                  std::uint64_t    den,
-                                                  Rep              value,
-                                                  TimeType         timeType,
-                                                  std::string_view replacementField) {
+        using TimeFormatter = std::optional<std::string> (Parser::*)(Rep,
+                                                                     TimeType,
+                                                                     std::string_view);
+
+        // One entry per std_ratios index, so a known ratio is a single indirect call instead of a
+        // compare against every entry. Aliases of the same ratio are the same std::ratio type and
+        // share one instantiation.
+        template<typename Rep>
+        static constexpr auto std_ratio_formatters
+          = []<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::array<TimeFormatter<Rep>, sizeof...(Is)>{
+                  &Parser::formatTimeFixedRatioImpl<
+                    Rep,
+                    typename std::tuple_element_t<Is, std_ratios>::type>...};
+            }(std::make_index_sequence<std::tuple_size_v<std_ratios>>{});
+
+        template<typename Rep>
+        std::optional<std::string> formatTimeImpl(std::uint64_t              num,
+                                                  std::uint64_t              den,
+                                                  std::optional<std::size_t> ratioIndex,
+                                                  Rep                        value,
+                                                  TimeType                   timeType,
+                                                  std::string_view           replacementField) {
             if constexpr(std::is_floating_point_v<Rep>) {
                 if(!timeValueSafeForFmt(num, den, value, replacementField)) { return std::nullopt; }
             }
-            std::optional<std::string> oStr;
-            bool                       failed = false;
-            auto format_std_ratio = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
-                using ratio = typename std::tuple_element_t<I, std_ratios>::type;
-                if(ratio::num == num && ratio::den == den) {
-                    oStr = formatTimeFixedRatioImpl<Rep, ratio>(value, timeType, replacementField);
-                    if(!oStr) { failed = true; }
-                    return false;
-                }
-                return true;
-            };
-
-            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                (format_std_ratio(std::integral_constant<std::size_t, Is>{}) && ...);
-            }(std::make_index_sequence<std::tuple_size_v<std_ratios>>{});
 
-            if(failed) { return std::nullopt; }
-            if(oStr) { return oStr; }
+            if(ratioIndex) {
+                return (this->*std_ratio_formatters<Rep>[*ratioIndex])(value,
+                                                                       timeType,
+                                                                       replacementField);
+            }
 
             if(replacementField == "{}" || replacementField == "{:%Q%q}") {
                 if(den == 1) { return fmt::format("{}[{}]s", value, num); }
@@ -631,23 +1231,74 @@ namespace detail {
             if(!timeValueSafeForFmt(num, den, value, replacementField)) { return std::nullopt; }
 
             //TODO not correct but otherwise the replacementField needs to be parsed further...
+            auto const timer = formatTimer();
             try {
                 auto const dur = std::chrono::duration<double>{
                   (static_cast<double>(value) * static_cast<double>(num))
                   / static_cast<double>(den)};
                 return fmt::format(fmt::runtime(replacementField), dur);
             } catch(std::exception const& e) {
-                errorMessagef(fmt::format(
-                  "bad format for replacement field {:?}: {} (custom ratio: {}/{}, value: {})",
-                  replacementField,
-                  e.what(),
-                  num,
-                  den,
-                  value));
+                error(ParseError::format,
+                      "bad format for replacement field {:?}: {} (custom ratio: {}/{}, value: {})",
+                      replacementField,
+                      e.what(),
+                      num,
+                      den,
+                      value);
                 return std::nullopt;
             }
         }
 
+        // The count that ends every time encoding, full or compact.
+        template<typename Iterator>
+        ParseResult<Iterator> parseTimeValue(Iterator                   first,
+                                             Iterator                   last,
+                                             std::uint64_t              numerator,
+                                             std::uint64_t              denominator,
+                                             std::optional<std::size_t> ratioIndex,
+                                             TimeType                   timeType,
+                                             TimeRepresentation         timeRep,
+                                             std::string_view           replacementField) {
+            if(byteSize(timeRep) > static_cast<std::size_t>(std::distance(first, last))) {
+                return std::nullopt;
+            }
+            tallyBytes(WireCategory::payload, byteSize(timeRep));
+
+            if(timeRep == TimeRepresentation::_float || timeRep == TimeRepresentation::_double) {
+                double const fpValue = (timeRep == TimeRepresentation::_float)
+                                       ? static_cast<double>(extract<float>(first, last))
+                                       : extract<double>(first, last);
+                first += static_cast<std::make_signed_t<std::size_t>>(byteSize(timeRep));
+                auto const optStr = formatTimeImpl(numerator,
+                                                   denominator,
+                                                   ratioIndex,
+                                                   fpValue,
+                                                   timeType,
+                                                   replacementField);
+                if(!optStr) { return std::nullopt; }
+                return {
+                  {*optStr, first}
+                };
+            }
+
+            auto const valueOpt = extractSigned(first, last, repToTypeSize(timeRep));
+            if(!valueOpt) { return std::nullopt; }
+            std::int64_t const value = *valueOpt;
+            first += static_cast<std::make_signed_t<std::size_t>>(byteSize(timeRep));
+
+            auto const optionalTrivial = formatTimeImpl(numerator,
+                                                        denominator,
+                                                        ratioIndex,
+                                                        value,
+                                                        timeType,
+                                                        replacementField);
+            if(!optionalTrivial) { return std::nullopt; }
+
+            return {
+              {*optionalTrivial, first}
+            };
+        }
+
         template<typename Iterator>
         ParseResult<Iterator> parseTime(Iterator         first,
                                         Iterator         last,
@@ -675,32 +1326,44 @@ namespace detail {
             first += static_cast<std::make_signed_t<std::size_t>>(byteSize(denominatorTypeSize));
 
             if(denominator == 0 || numerator == 0) { return std::nullopt; }
+            tallyBytes(WireCategory::type_identifier,
+                       1 + byteSize(numSize) + byteSize(denominatorTypeSize));
 
-            if(timeRep == TimeRepresentation::_float || timeRep == TimeRepresentation::_double) {
-                double const fpValue = (timeRep == TimeRepresentation::_float)
-                                       ? static_cast<double>(extract<float>(first, last))
-                                       : extract<double>(first, last);
-                first += static_cast<std::make_signed_t<std::size_t>>(byteSize(timeRep));
-                auto const optStr
-                  = formatTimeImpl(numerator, denominator, fpValue, timeType, replacementField);
-                if(!optStr) { return std::nullopt; }
-                return {
-                  {*optStr, first}
-                };
-            }
+            return parseTimeValue(first,
+                                  last,
+                                  numerator,
+                                  denominator,
+                                  findStdRatio(numerator, denominator),
+                                  timeType,
+                                  timeRep,
+                                  replacementField);
+        }
 
-            auto const valueOpt = extractSigned(first, last, repToTypeSize(timeRep));
-            if(!valueOpt) { return std::nullopt; }
-            std::int64_t const value = *valueOpt;
-            first += static_cast<std::make_signed_t<std::size_t>>(byteSize(timeRep));
+        template<typename Iterator>
+        ParseResult<Iterator> parseStdRatioTime(Iterator         first,
+                                                Iterator         last,
+                                                std::string_view replacementField) {
+            if(first == last) { return std::nullopt; }
+            auto const timeTypeId = parseStdRatioTimeTypeIdentifier(*first);
+            if(!timeTypeId) { return std::nullopt; }
+            ++first;
+            auto const [timeType, timeRep] = *timeTypeId;
 
-            auto const optionalTrivial
-              = formatTimeImpl(numerator, denominator, value, timeType, replacementField);
-            if(!optionalTrivial) { return std::nullopt; }
+            if(first == last) { return std::nullopt; }
+            auto const ratioIndex = static_cast<std::size_t>(*first);
+            if(ratioIndex >= std_ratio_table.size()) { return std::nullopt; }
+            ++first;
+            tallyBytes(WireCategory::type_identifier, 2);
 
-            return {
-              {*optionalTrivial, first}
-            };
+            auto const [numerator, denominator] = std_ratio_table[ratioIndex];
+            return parseTimeValue(first,
+                                  last,
+                                  numerator,
+                                  denominator,
+                                  ratioIndex,
+                                  timeType,
+                                  timeRep,
+                                  replacementField);
         }
 
         template<typename Iterator>
@@ -717,12 +1380,18 @@ namespace detail {
 
             auto const stringIt = stringConstantsMap.find(static_cast<std::uint16_t>(size));
             if(stringIt == stringConstantsMap.end()) {
-                errorMessagef(fmt::format("cataloged string not found {}", size));
+                error(ParseError::catalog_miss, "cataloged string not found {}", size);
                 return std::nullopt;
             }
 
-            std::string const catalogedString = stringIt->second;
+            std::string const& catalogedString = stringIt->second;
+            if(!in_list && replacementField == Default_replacement_field) {
+                return {
+                  {catalogedString, first}
+                };
+            }
 
+            auto const timer = formatTimer();
             try {
                 auto const ret = [&]() {
                     if(in_list && replacementField == Default_replacement_field) {
@@ -734,14 +1403,14 @@ namespace detail {
                   {ret, first}
                 };
             } catch(std::exception const& e) {
-                errorMessagef(
-                  fmt::format("bad format for replacement field {:?}: {} (string: \"{}\", length: "
-                              "{}, in_list: {})\n",
-                              replacementField,
-                              e.what(),
-                              catalogedString,
-                              catalogedString.length(),
-                              in_list));
+                error(ParseError::format,
+                      "bad format for replacement field {:?}: {} (string: \"{}\", length: "
+                      "{}, in_list: {})\n",
+                      replacementField,
+                      e.what(),
+                      catalogedString,
+                      catalogedString.length(),
+                      in_list);
                 return std::nullopt;
             }
         }
@@ -755,15 +1424,19 @@ namespace detail {
                                           bool             in_list) {
             if(size > static_cast<std::size_t>(std::distance(first, last))) { return std::nullopt; }
             if(rangeLayout != RangeLayout::compact) { return std::nullopt; }
-            std::string parsedString;
-            parsedString.resize(size);
+            tallyBytes(WireCategory::payload, size);
 
+            // Formatted straight from the buffer: the only copy is the one into the result.
             auto const string_end
               = std::next(first, static_cast<std::make_signed_t<std::size_t>>(size));
-            std::transform(first, string_end, parsedString.begin(), [](auto byte) {
-                return static_cast<char>(byte);
-            });
+            std::string_view const parsedString = asText(first, string_end);
+            if(!in_list && replacementField == Default_replacement_field) {
+                return {
+                  {std::string{parsedString}, string_end}
+                };
+            }
 
+            auto const timer = formatTimer();
             try {
                 auto const ret = [&]() {
                     if(in_list && replacementField == Default_replacement_field) {
@@ -775,20 +1448,20 @@ namespace detail {
                   {ret, string_end}
                 };
             } catch(std::exception const& e) {
-                errorMessagef(
-                  fmt::format("bad format for replacement field {:?}: {} (string: \"{}\", size: "
-                              "{}, in_list: {})",
-                              replacementField,
-                              e.what(),
-                              parsedString,
-                              size,
-                              in_list));
+                error(ParseError::format,
+                      "bad format for replacement field {:?}: {} (string: \"{}\", size: "
+                      "{}, in_list: {})",
+                      replacementField,
+                      e.what(),
+                      parsedString,
+                      size,
+                      in_list);
                 return std::nullopt;
             }
         }
 
         // NOTE: This function handles parsing of extended type identifiers.
-        // Recursion is bounded by the depth of nested data structures in the serialized format.
+        // Recursion depth is bounded by max_parse_depth, see parseFromTypeId.
         template<typename Iterator>
         ParseResult<Iterator>
         parseExtendedTypeIdentifier(Iterator                               first,
@@ -859,7 +1532,7 @@ namespace detail {
         }
 
         // NOTE: This function parses tuple structures, which can contain nested elements.
-        // Recursion depth is bounded by the nesting level of tuples in the serialized data.
+        // Recursion depth is bounded by max_parse_depth, see parseFromTypeId.
         template<typename Iterator>
         ParseResult<Iterator>
         parseTuple(Iterator                               first,
@@ -911,8 +1584,239 @@ namespace detail {
             };
         }
 
+        // Rendered like a designated initializer without the dots, {id: 7, gain: 1.5}. A nested
+        // spec applies to every field, as it does to every element of a tuple.
+        template<typename Iterator>
+        ParseResult<Iterator> parseAggregate(Iterator         first,
+                                             Iterator         last,
+                                             std::string_view schema,
+                                             std::string_view replacementField,
+                                             bool             in_map) {
+            if(in_map || schema.empty() || schema.ends_with(',')) { return std::nullopt; }
+
+            auto const oRangeRepField = fixRangeReplacementField(replacementField);
+            if(!oRangeRepField) { return std::nullopt; }
+            auto const& [rangeReplacementField, childReplacementField] = *oRangeRepField;
+
+            bool const printBraces = !rangeReplacementField.contains('n');
+
+            std::string aggregateString = printBraces ? "{" : "";
+            while(!schema.empty()) {
+                auto const comma = schema.find(',');
+                auto const field = schema.substr(0, comma);
+                schema = comma == std::string_view::npos ? std::string_view{}
+                                                         : schema.substr(comma + 1);
+
+                auto const colon = field.rfind(':');
+                if(colon == 0 || colon == std::string_view::npos) { return std::nullopt; }
+                auto const fieldType = parseAggregateFieldCode(field.substr(colon + 1));
+                if(!fieldType) { return std::nullopt; }
+
+                auto const optionalStr = extractAndFormatTrivial(first,
+                                                                 last,
+                                                                 childReplacementField,
+                                                                 fieldType->first,
+                                                                 fieldType->second,
+                                                                 true);
+                if(!optionalStr) { return std::nullopt; }
+                aggregateString += field.substr(0, colon);
+                aggregateString += ": ";
+                aggregateString += optionalStr->str;
+                first = optionalStr->pos;
+                if(!schema.empty()) { aggregateString += ", "; }
+            }
+
+            if(printBraces) { aggregateString += '}'; }
+            return {
+              {aggregateString, first}
+            };
+        }
+
+        // One piece of a compact range's element schema: identifier bytes taken from the stream,
+        // followed by this many payload bytes in every element.
+        template<typename Iterator>
+        struct SchemaSegment {
+            Iterator    headerFirst;
+            Iterator    headerLast;
+            std::size_t payloadSize;
+        };
+
+        // NOTE: Recursion depth is bounded by the nesting level of tuples in the schema, which
+        // counts against max_parse_depth like any other nesting.
+        template<typename Iterator>
+        std::optional<Iterator>
+        parseSchema(Iterator                                    first,
+                    Iterator                                    last,
+                    std::vector<SchemaSegment<Iterator>>&       segments,
+                    std::unordered_map<std::uint16_t,
+                                       std::string> const&      stringConstantsMap) {
+            if(first == last) { return std::nullopt; }
+            auto const available = static_cast<std::size_t>(std::distance(first, last));
+
+            if(auto const trivialTypeId = parseTrivialTypeIdentifier(*first)) {
+                tallyTrivial(trivialTypeId->first, WireCategory::type_identifier, 1, 0);
+                segments.push_back({first, std::next(first), byteSize(trivialTypeId->second)});
+                return std::next(first);
+            }
+            if(auto const compactTime = parseStdRatioTimeTypeIdentifier(*first)) {
+                if(available < 2) { return std::nullopt; }
+                if(static_cast<std::size_t>(*std::next(first))
+                   >= std::tuple_size_v<detail::std_ratios>)
+                {
+                    return std::nullopt;
+                }
+                tallyBytes(WireCategory::type_identifier, 2);
+                segments.push_back({first, std::next(first, 2), byteSize(compactTime->second)});
+                return std::next(first, 2);
+            }
+            if(auto const timeTypeId = parseTimeTypeIdentifier(*first)) {
+                auto const [timeType, numSize, denSize, timeRep] = *timeTypeId;
+                auto const headerSize = 1 + byteSize(numSize) + byteSize(denSize);
+                if(available < headerSize) { return std::nullopt; }
+                tallyBytes(WireCategory::type_identifier, headerSize);
+                auto const headerLast
+                  = std::next(first, static_cast<std::make_signed_t<std::size_t>>(headerSize));
+                segments.push_back({first, headerLast, byteSize(timeRep)});
+                return headerLast;
+            }
+
+            auto const rangeTypeId = parseRangeTypeIdentifier(*first);
+            if(!rangeTypeId) { return std::nullopt; }
+            auto const [rangeType, rangeSize, rangeLayout] = *rangeTypeId;
+            if(rangeType == RangeType::extendedTypeIdentifier
+               && rangeLayout == RangeLayout::compact)
+            {
+                return parseExtendedSchema(first, last, rangeSize, segments, stringConstantsMap);
+            }
+            if(rangeType != RangeType::tuple || rangeLayout != RangeLayout::on_ti_each) {
+                return std::nullopt;
+            }
+
+            auto const optionalSize
+              = extractSize(std::next(first), last, rangeSizeToTypeSize(rangeSize));
+            if(!optionalSize) { return std::nullopt; }
+            tallyBytes(WireCategory::type_identifier, 1);
+            tallyBytes(WireCategory::size, byteSize(rangeSize));
+            segments.push_back({first, optionalSize->second, 0});
+
+            if(!enterLevel()) { return std::nullopt; }
+            LevelExit const levelExit{depth};
+            auto            iterator = optionalSize->second;
+            for(std::size_t element = 0; element < optionalSize->first; ++element) {
+                auto const next = parseSchema(iterator, last, segments, stringConstantsMap);
+                if(!next) { return std::nullopt; }
+                iterator = *next;
+            }
+            return iterator;
+        }
+
+        // An aggregate, or an enum with a table of names: the header runs to the end of the string
+        // that carries the schema or the names.
+        template<typename Iterator>
+        std::optional<Iterator>
+        parseExtendedSchema(Iterator                                    first,
+                            Iterator                                    last,
+                            RangeSize                                   rangeSize,
+                            std::vector<SchemaSegment<Iterator>>&       segments,
+                            std::unordered_map<std::uint16_t,
+                                               std::string> const&      stringConstantsMap) {
+            auto const eti = extractSize(std::next(first), last, rangeSizeToTypeSize(rangeSize));
+            if(!eti) { return std::nullopt; }
+            tallyBytes(WireCategory::type_identifier, 1 + byteSize(rangeSize));
+            auto iterator = eti->second;
+
+            std::size_t payloadSize = 0;
+            if(eti->first == static_cast<std::size_t>(ExtendedTypeIdentifier::enumeration)) {
+                if(iterator == last) { return std::nullopt; }
+                auto const indexTypeId = parseTrivialTypeIdentifier(*iterator);
+                if(!indexTypeId) { return std::nullopt; }
+                payloadSize = byteSize(indexTypeId->second);
+                // The index type and the count of names.
+                if(std::distance(iterator, last) < 3) { return std::nullopt; }
+                tallyBytes(WireCategory::type_identifier, 1);
+                tallyBytes(WireCategory::size, 2);
+                iterator = std::next(iterator, 3);
+            } else if(eti->first != static_cast<std::size_t>(ExtendedTypeIdentifier::aggregate)) {
+                return std::nullopt;
+            }
+
+            if(iterator == last) { return std::nullopt; }
+            auto const stringTypeId = parseRangeTypeIdentifier(*iterator);
+            if(!stringTypeId
+               || (std::get<0>(*stringTypeId) != RangeType::string
+                   && std::get<0>(*stringTypeId) != RangeType::cataloged_string))
+            {
+                return std::nullopt;
+            }
+            auto const text = parseSchemaText(iterator, last, stringConstantsMap);
+            if(!text) { return std::nullopt; }
+
+            if(eti->first == static_cast<std::size_t>(ExtendedTypeIdentifier::aggregate)) {
+                auto const aggregateSize = aggregatePayloadSize(text->str);
+                if(!aggregateSize) { return std::nullopt; }
+                payloadSize = *aggregateSize;
+            }
+            segments.push_back({first, text->pos, payloadSize});
+            return text->pos;
+        }
+
+        // The string that carries the schema of an aggregate or the names of an enum. Its text is
+        // spent on types, not on values.
+        template<typename Iterator>
+        ParseResult<Iterator>
+        parseSchemaText(Iterator                               first,
+                        Iterator                               last,
+                        std::unordered_map<std::uint16_t,
+                                           std::string> const& stringConstantsMap) {
+            bool const outerSchemaText = std::exchange(inSchemaText, true);
+            auto const text
+              = parseRange(first, last, "{}", false, false, stringConstantsMap);
+            inSchemaText = outerSchemaText;
+            return text;
+        }
+
+        // Puts the schema and this element's payload back together, as the element would have
+        // been sent on its own, and parses that.
+        template<typename Iterator>
+        ParseResult<Iterator>
+        parseSchemaElement(Iterator                                    first,
+                           Iterator                                    last,
+                           std::vector<SchemaSegment<Iterator>> const& segments,
+                           std::vector<std::byte>&                     element,
+                           std::string_view                            replacementField,
+                           bool                                        in_map,
+                           std::unordered_map<std::uint16_t,
+                                              std::string> const&      stringConstantsMap) {
+            element.clear();
+            for(auto const& segment : segments) {
+                element.insert(element.end(), segment.headerFirst, segment.headerLast);
+                if(segment.payloadSize > static_cast<std::size_t>(std::distance(first, last))) {
+                    return std::nullopt;
+                }
+                auto const payloadLast
+                  = std::next(first,
+                              static_cast<std::make_signed_t<std::size_t>>(segment.payloadSize));
+                element.insert(element.end(), first, payloadLast);
+                first = payloadLast;
+            }
+
+            std::span<std::byte const> const elementSpan{element};
+            bool const                       outerElement = std::exchange(inElement, true);
+            auto const                       optionalStr  = parseFromTypeId(elementSpan.begin(),
+                                                     elementSpan.end(),
+                                                     replacementField,
+                                                     true,
+                                                     in_map,
+                                                     stringConstantsMap);
+            inElement = outerElement;
+            if(!optionalStr || optionalStr->pos != elementSpan.end()) { return std::nullopt; }
+            return {
+              {optionalStr->str, first}
+            };
+        }
+
         // NOTE: This function parses list/collection structures.
-        // Recursion depth is bounded by the nesting level of lists in the serialized data.
+        // Recursion depth is bounded by max_parse_depth, see parseFromTypeId.
         template<typename Iterator>
         ParseResult<Iterator> parseList(Iterator                               first,
                                         Iterator                               last,
@@ -937,17 +1841,51 @@ namespace detail {
             // Reserve space to reduce reallocations during string building
             listString.reserve((size * 10) + (printParenthesis ? 2 : 0));   // Rough estimate
 
+            bool const elementsInMap = rangeType == RangeType::map
+                                    || rangeReplacementField.contains('m');
+
+            // A compact range starts with the element schema. A single trivial identifier is read
+            // directly; anything else is kept as segments and reassembled per element.
             std::optional<std::tuple<TrivialType, TypeSize>> trivialTypeId;
+            std::vector<SchemaSegment<Iterator>>             schema;
+            std::vector<std::byte>                           element;
 
             if(rangeLayout == RangeLayout::compact && size != 0 && first != last) {
                 trivialTypeId = parseTrivialTypeIdentifier(*first);
-                if(!trivialTypeId) { return std::nullopt; }
-
-                ++first;
+                if(trivialTypeId) {
+                    ++first;
+                    auto const [trivialType, typeSize] = *trivialTypeId;
+                    tallyTrivial(trivialType, WireCategory::type_identifier, 1, 0);
+                    if(auto const spec = simpleIntegerSpec(trivialType, childReplacementField)) {
+                        auto const payloadLast = appendIntegerRange(listString,
+                                                                    first,
+                                                                    last,
+                                                                    size,
+                                                                    trivialType,
+                                                                    typeSize,
+                                                                    *spec);
+                        if(!payloadLast) { return std::nullopt; }
+                        first = *payloadLast;
+                        size  = 0;
+                    }
+                } else {
+                    auto const schemaLast = parseSchema(first, last, schema, stringConstantsMap);
+                    if(!schemaLast) { return std::nullopt; }
+                    first = *schemaLast;
+                }
             }
 
             while(size != 0 && first != last) {
                 auto const optionalStr = [&]() {
+                    if(rangeLayout == RangeLayout::compact && !trivialTypeId) {
+                        return parseSchemaElement(first,
+                                                  last,
+                                                  schema,
+                                                  element,
+                                                  childReplacementField,
+                                                  elementsInMap,
+                                                  stringConstantsMap);
+                    }
                     if(rangeLayout == RangeLayout::compact) {
                         auto [trivialType, typeSize] = *trivialTypeId;
                         // in_list is true here for the same reason the non-compact branch below
@@ -964,8 +1902,7 @@ namespace detail {
                                            last,
                                            childReplacementField,
                                            true,
-                                           rangeType == RangeType::map
-                                             || rangeReplacementField.contains('m'),
+                                           elementsInMap,
                                            stringConstantsMap);
                 }();
                 if(!optionalStr) { return std::nullopt; }
@@ -983,7 +1920,7 @@ namespace detail {
         }
 
         // NOTE: This function parses range structures which can contain nested elements.
-        // Recursion depth is bounded by the nesting level of ranges in the serialized data.
+        // Recursion depth is bounded by max_parse_depth, see parseFromTypeId.
         template<typename Iterator>
         ParseResult<Iterator>
         parseRange(Iterator                               first,
@@ -1001,6 +1938,13 @@ namespace detail {
 
             auto optionalSize = extractSize(first, last, rangeSizeToTypeSize(rangeSize));
             if(!optionalSize) { return std::nullopt; }
+            // The size of a cataloged string is its id, that of an extended identifier its type.
+            tallyBytes(WireCategory::type_identifier, 1);
+            tallyBytes(rangeType == RangeType::cataloged_string ? WireCategory::catalog_id
+                       : rangeType == RangeType::extendedTypeIdentifier
+                         ? WireCategory::type_identifier
+                         : WireCategory::size,
+                       byteSize(rangeSize));
 
             first = optionalSize->second;
             switch(rangeType) {
@@ -1051,7 +1995,7 @@ namespace detail {
         }
 
         // NOTE: This function dispatches parsing based on type identifiers.
-        // Recursion depth is bounded by the complexity of nested type structures in the data.
+        // Recursion depth is bounded by max_parse_depth, see parseFromTypeId.
         template<typename Iterator>
         ParseResult<Iterator> parseType(Iterator                               first,
                                         Iterator                               last,
@@ -1065,6 +2009,9 @@ namespace detail {
             switch(typeId) {
             case TypeIdentifier::fmt_string: return std::nullopt;
             case TypeIdentifier::trivial:
+                if(isCompactTypeIdentifier(*first)) {
+                    return parseStdRatioTime(first, last, replacementField);
+                }
                 return parseTrivial(first, last, replacementField, in_list);
             case TypeIdentifier::time: return parseTime(first, last, replacementField);
             case TypeIdentifier::range:
@@ -1079,7 +2026,7 @@ namespace detail {
         }
 
         template<typename Iterator>
-        ParseResult<Iterator>
+        TextResult<Iterator>
         parseFmtString(Iterator                               first,
                        Iterator                               last,
                        FmtStringType                          type,
@@ -1096,32 +2043,41 @@ namespace detail {
             iterator = optionalSize->second;
 
             auto const fmtStringSize = optionalSize->first;
+            tallyBytes(WireCategory::type_identifier, 1);
 
-            std::string fmtString;
+            std::string_view fmtString;
             if(type == FmtStringType::normal || type == FmtStringType::sub) {
                 if(fmtStringSize > static_cast<std::size_t>(std::distance(iterator, last))) {
                     return std::nullopt;
                 }
 
-                fmtString.resize(fmtStringSize);
-
-                std::transform(
-                  iterator,
-                  std::next(iterator, static_cast<std::make_signed_t<std::size_t>>(fmtStringSize)),
-                  fmtString.begin(),
-                  [](auto byte) { return static_cast<char>(byte); });
-
-                std::advance(iterator, fmtStringSize);
+                auto const fmtStringLast
+                  = std::next(iterator, static_cast<std::make_signed_t<std::size_t>>(fmtStringSize));
+                fmtString = asText(iterator, fmtStringLast);
+                iterator  = fmtStringLast;
+                tallyBytes(WireCategory::size, byteSize(*optionalFmtRangeSize));
+                tallyBytes(WireCategory::format_string, fmtStringSize);
+                tally.fmtString(std::nullopt, fmtString);
             } else {
                 auto const fmtStringIt
                   = stringConstantsMap.find(static_cast<std::uint16_t>(fmtStringSize));
                 if(fmtStringIt == stringConstantsMap.end()) {
-                    errorMessagef(
-                      fmt::format("cataloged format string not found {}", fmtStringSize));
+                    error(ParseError::catalog_miss,
+                          "cataloged format string not found {}",
+                          fmtStringSize);
                     return std::nullopt;
                 }
 
                 fmtString = fmtStringIt->second;
+                tallyBytes(WireCategory::catalog_id, byteSize(*optionalFmtRangeSize));
+                tally.fmtString(static_cast<std::uint16_t>(fmtStringSize), fmtString);
+            }
+
+            // Only a whole message carries a level; a nested format string with one is refused
+            // below like any other control character.
+            if(type == FmtStringType::normal || type == FmtStringType::cataloged_normal) {
+                level = levelFromPrefix(fmtString);
+                if(level) { fmtString.remove_prefix(1); }
             }
 
             if(!checkReplacementFieldCount(fmtString)) { return std::nullopt; }
@@ -1132,8 +2088,67 @@ namespace detail {
             };
         }
 
-        // NOTE: This function handles format string parsing with nested arguments.
-        // Recursion occurs when parsing nested format specifiers and is bounded by format complexity.
+        bool replacementFieldAccepted(std::string_view replacementField) {
+            if(replacementFieldWithinLimits(replacementField)) { return true; }
+            error(ParseError::unsupported_field,
+                  "replacement field {:?} is a dynamic spec or carries a "
+                  "number above the limit of {}",
+                  replacementField,
+                  Max_replacement_field_number);
+            return false;
+        }
+
+        // A flags group answers the current replacement field and one more per further flag, so
+        // unlike every other argument it consumes the format string as well. The literal text
+        // between those fields is part of the returned string.
+        template<typename Iterator>
+        ParseResult<Iterator> parseFlags(Iterator          first,
+                                         Iterator          last,
+                                         std::string_view  replacementField,
+                                         std::string_view& fmtString) {
+            auto const rangeSize = parseFlagsTypeIdentifier(*first);
+            if(!rangeSize) { return std::nullopt; }
+            std::byte const identifier = *first;
+            ++first;
+
+            auto const optionalPacked = extractSize(first, last, rangeSizeToTypeSize(*rangeSize));
+            if(!optionalPacked) { return std::nullopt; }
+            first = optionalPacked->second;
+
+            auto const packed = static_cast<std::uint16_t>(optionalPacked->first);
+            if(packed == 0) { return std::nullopt; }
+            auto const count = static_cast<std::size_t>(std::bit_width(packed)) - 1;
+            // Only the encoding appendFlags produces: the wide form is used for 8 flags or more.
+            if(count == 0 || (*rangeSize == RangeSize::_2) != (count >= 8)) { return std::nullopt; }
+            tally.enterArgument(identifier, count);
+            tallyTrivial(TrivialType::boolean, WireCategory::type_identifier, 1, 0);
+            tallyTrivial(TrivialType::boolean, WireCategory::payload, byteSize(*rangeSize), count);
+            tally.leaveArgument();
+
+            std::string ret;
+            for(std::size_t flag = 0; flag < count; ++flag) {
+                if(flag != 0) {
+                    auto const optionalReplacementField
+                      = getNextReplacementFieldFromFmtStringAndAppendStrings(ret, fmtString);
+                    if(!optionalReplacementField) { return std::nullopt; }
+                    if(!replacementFieldAccepted(*optionalReplacementField)) { return std::nullopt; }
+                    replacementField = *optionalReplacementField;
+                }
+                auto const optionalStr = formatTrivial(((packed >> flag) & 1U) != 0,
+                                                       replacementField,
+                                                       TrivialType::boolean,
+                                                       TypeSize::_1,
+                                                       false);
+                if(!optionalStr) { return std::nullopt; }
+                ret += *optionalStr;
+            }
+            return {
+              {ret, first}
+            };
+        }
+
+        // NOTE: This function handles format string parsing with nested arguments. A nested
+        // format string is reached through parseFromTypeId, so it counts against max_parse_depth.
         template<typename Iterator>
         ParseResult<Iterator> parseFmt(Iterator                               first,
                                        Iterator                               last,
@@ -1154,21 +2169,21 @@ namespace detail {
                 auto const optionalReplacementField
                   = getNextReplacementFieldFromFmtStringAndAppendStrings(ret, fmtString);
                 if(!optionalReplacementField) { break; }
-                if(!replacementFieldWithinLimits(*optionalReplacementField)) {
-                    errorMessagef(
-                      fmt::format("replacement field {:?} is a dynamic spec or carries a number "
-                                  "above the limit "
-                                  "of {}",
-                                  *optionalReplacementField,
-                                  Max_replacement_field_number));
-                    return std::nullopt;
-                }
-                auto const optionalStr = parseFromTypeId(iterator,
-                                                         last,
-                                                         *optionalReplacementField,
-                                                         false,
-                                                         false,
-                                                         stringConstantsMap);
+                if(!replacementFieldAccepted(*optionalReplacementField)) { return std::nullopt; }
+                auto const optionalStr = [&]() {
+                    if(parseFlagsTypeIdentifier(*iterator)) {
+                        return parseFlags(iterator, last, *optionalReplacementField, fmtString);
+                    }
+                    tally.enterArgument(*iterator, 1);
+                    auto argument = parseFromTypeId(iterator,
+                                                    last,
+                                                    *optionalReplacementField,
+                                                    false,
+                                                    false,
+                                                    stringConstantsMap);
+                    tally.leaveArgument();
+                    return argument;
+                }();
                 if(!optionalStr) { return std::nullopt; }
                 iterator = optionalStr->pos;
                 ret += optionalStr->str;
@@ -1179,8 +2194,9 @@ namespace detail {
             };
         }
 
-        // NOTE: This is the main entry point for recursive parsing of data structures.
-        // Recursion depth is naturally bounded by the structure of the serialized data being parsed.
+        // NOTE: This is the main entry point for recursive parsing of data structures. Every
+        // nested value comes through here, so this is where the depth is bounded: past
+        // max_parse_depth the frame fails without reading further.
         template<typename Iterator>
         ParseResult<Iterator>
         parseFromTypeId(Iterator                               first,
@@ -1190,6 +2206,20 @@ namespace detail {
                         bool                                   in_map,
                         std::unordered_map<std::uint16_t,
                                            std::string> const& stringConstantsMap) {
+            if(!enterLevel()) { return std::nullopt; }
+            LevelExit const levelExit{depth};
+            return parseNested(first, last, replacementField, in_list, in_map, stringConstantsMap);
+        }
+
+        template<typename Iterator>
+        ParseResult<Iterator>
+        parseNested(Iterator                               first,
+                    Iterator                               last,
+                    std::string_view                       replacementField,
+                    bool                                   in_list,
+                    bool                                   in_map,
+                    std::unordered_map<std::uint16_t,
+                                       std::string> const& stringConstantsMap) {
             if(first == last) { return std::nullopt; }
 
             TypeIdentifier const typeId = static_cast<TypeIdentifier>(*first & std::byte{0x03});
@@ -1212,6 +2242,320 @@ namespace detail {
     };
 }   // namespace detail
 
+// What a frame carries besides its message.
+struct FrameInfo {
+    // Set by a leveled print. It comes from the format string, so it is known even when formatting
+    // the arguments fails.
+    std::optional<Level> level;
+    // Frames the device dropped for lack of transport capacity before sending this one. Also
+    // passed to the error callback, so a caller of plain parse sees the gap too.
+    std::uint32_t dropped_before{};
+};
+
+// Counts what parseFrame sees, for a caller that passes one. A Stats type has the members of
+// NoStats; deriving from NoStats and hiding some of them counts only those. With timed set,
+// parseFrame also reports the time per ParseStage, at the cost of reading the clock around every
+// formatted value.
+struct NoStats {
+    static constexpr bool timed = false;
+
+    // A frame of that many bytes became a message.
+    void frame(std::size_t /*bytes*/) {}
+    // A complete frame did not parse.
+    void rejected() {}
+    // Bytes skipped while looking for the start of a frame.
+    void discarded(std::size_t /*bytes*/) {}
+    // Passed to the error callback as well.
+    void error(ParseError /*error*/) {}
+    // Frames the device dropped before this one, from a drop report.
+    void dropped(std::uint32_t /*frames*/) {}
+    void time(ParseStage /*stage*/,
+              std::chrono::nanoseconds /*duration*/) {}
+};
+
+struct ParseStats {
+    static constexpr bool timed = false;
+
+    std::uint64_t frames{};
+    std::uint64_t frame_bytes{};
+    std::uint64_t rejected_frames{};
+    std::uint64_t discarded_bytes{};
+    std::uint64_t dropped_by_device{};
+    std::array<std::uint64_t, enchantum::count<ParseError>>             errors{};
+    std::array<std::chrono::nanoseconds, enchantum::count<ParseStage>> stage_time{};
+
+    std::uint64_t operator[](ParseError error) const {
+        return errors[static_cast<std::size_t>(error)];
+    }
+
+    std::chrono::nanoseconds operator[](ParseStage stage) const {
+        return stage_time[static_cast<std::size_t>(stage)];
+    }
+
+    void frame(std::size_t bytes) {
+        ++frames;
+        frame_bytes += bytes;
+    }
+
+    void rejected() { ++rejected_frames; }
+
+    void discarded(std::size_t bytes) { discarded_bytes += bytes; }
+
+    void error(ParseError error) { ++errors[static_cast<std::size_t>(error)]; }
+
+    void dropped(std::uint32_t frames_) { dropped_by_device += frames_; }
+
+    void time(ParseStage               stage,
+              std::chrono::nanoseconds duration) {
+        stage_time[static_cast<std::size_t>(stage)] += duration;
+    }
+};
+
+struct TimedParseStats : ParseStats {
+    static constexpr bool timed = true;
+};
+
+namespace detail {
+    // What parseFrame's Parser reports to: stats, then the caller's callback.
+    template<typename Stats,
+             typename ErrorMessageF,
+             bool = takes_messages<ErrorMessageF>>
+    struct FrameSink {
+        Stats&         stats;
+        ErrorMessageF& errorMessagef;
+
+        void operator()(ParseError       error,
+                        std::string_view message) {
+            stats.error(error);
+            reportError(errorMessagef, error, message);
+        }
+    };
+
+    template<typename Stats,
+             typename ErrorMessageF>
+    struct FrameSink<Stats,
+                     ErrorMessageF,
+                     false> : NullSink {
+        Stats&         stats;
+        ErrorMessageF& errorMessagef;
+
+        FrameSink(Stats&         stats_,
+                  ErrorMessageF& errorMessagef_)
+          : stats{stats_}
+          , errorMessagef{errorMessagef_} {}
+
+        void operator()(ParseError error) {
+            stats.error(error);
+            errorMessagef(error);
+        }
+    };
+
+    template<typename Stats>
+    std::chrono::steady_clock::time_point stageStart() {
+        if constexpr(Stats::timed) {
+            return std::chrono::steady_clock::now();
+        } else {
+            return {};
+        }
+    }
+
+    // The frame at the start of buffer, which holds an end marker somewhere. On success buffer
+    // is moved past the frame.
+    template<typename Sink,
+             typename Tally>
+    std::optional<std::string>
+    decodeFrame(std::span<std::byte const>&            buffer,
+                std::unordered_map<std::uint16_t,
+                                   std::string> const& stringConstantsMap,
+                Parser<Sink, Tally>&                   parser,
+                FrameInfo&                             info) {
+        auto first = std::next(buffer.begin());
+        parser.level.reset();
+        parser.tally.frame();
+        parser.tallyBytes(WireCategory::framing, 1);
+
+        // Only reported once the frame is accepted: a rejected frame is retried, and a noise byte
+        // may look like a drop report.
+        std::uint32_t dropped{};
+        if(auto const typeSize = parseDropReportTypeIdentifier(*first)) {
+            auto const optionalCount
+              = parser.extractSize(std::next(first), buffer.end(), *typeSize);
+            // Only the encoding appendDropReport produces: a count above 0, in the narrowest
+            // size.
+            if(!optionalCount || optionalCount->first == 0
+               || sizeToTypeSize(optionalCount->first) != *typeSize)
+            {
+                return std::nullopt;
+            }
+            first   = optionalCount->second;
+            dropped = static_cast<std::uint32_t>(optionalCount->first);
+            parser.tallyBytes(WireCategory::framing, 1 + byteSize(*typeSize));
+            if(first == buffer.end()) { return std::nullopt; }
+        }
+
+        FmtStringType const fmtStringType = [&]() {
+            if(parseFmtStringTypeIdentifier(*first, FmtStringType::normal)) {
+                return FmtStringType::normal;
+            }
+            return FmtStringType::cataloged_normal;
+        }();
+
+        auto const optionalStr
+          = parser.parseFmt(first, buffer.end(), fmtStringType, stringConstantsMap);
+        info.level = parser.level;
+
+        if(!optionalStr) { return std::nullopt; }
+        if(optionalStr->pos == buffer.end() || *optionalStr->pos != protocol::End_marker) {
+            return std::nullopt;
+        }
+        parser.tallyBytes(WireCategory::framing, 1);
+        if(dropped != 0) {
+            info.dropped_before = dropped;
+            parser.error(ParseError::device_drop,
+                         "{} frames dropped by the device before this one",
+                         dropped);
+        }
+        buffer = buffer.subspan(
+          static_cast<std::size_t>(std::distance(buffer.begin(), optionalStr->pos + 1)));
+        return optionalStr->str;
+    }
+
+    // parseFrame with a Parser whose sink counts into stats.
+    template<typename Sink,
+             typename Tally,
+             typename Stats>
+    std::tuple<std::optional<std::string>,
+               std::span<std::byte const>,
+               std::size_t,
+               FrameInfo>
+    parseFrameWith(std::span<std::byte const>             buffer,
+                   std::unordered_map<std::uint16_t,
+                                      std::string> const& stringConstantsMap,
+                   Parser<Sink, Tally>&                   parser,
+                   Stats&                                 stats) {
+        auto const  resyncStart = stageStart<Stats>();
+        std::size_t unparsed_bytes{};
+        while(!buffer.empty()) {
+            auto const        iterator = std::ranges::find(buffer, protocol::Start_marker);
+            std::size_t const offset
+              = static_cast<std::size_t>(std::distance(buffer.begin(), iterator));
+            buffer = buffer.subspan(offset);
+            unparsed_bytes += offset;
+            if(2 > buffer.size() || parseFmtStringTypeIdentifier(buffer[1], FmtStringType::normal)
+               || parseFmtStringTypeIdentifier(buffer[1], FmtStringType::cataloged_normal)
+               || parseDropReportTypeIdentifier(buffer[1]))
+            {
+                break;
+            }
+            unparsed_bytes += 1;
+            buffer = buffer.subspan(1);
+        }
+
+        bool const contains_end = std::ranges::find(buffer, protocol::End_marker) != buffer.end();
+
+        stats.discarded(unparsed_bytes);
+        if constexpr(Stats::timed) {
+            stats.time(ParseStage::resync, std::chrono::steady_clock::now() - resyncStart);
+        }
+
+        if(2 > buffer.size() || !contains_end) {
+            return {std::nullopt, buffer, unparsed_bytes, {}};
+        }
+
+        auto const               decodeStart = stageStart<Stats>();
+        std::chrono::nanoseconds formatTime{};
+        if constexpr(Stats::timed) { parser.formatTime = &formatTime; }
+
+        FrameInfo         info{};
+        std::size_t const size    = buffer.size();
+        auto              message = decodeFrame(buffer, stringConstantsMap, parser, info);
+        parser.formatTime         = nullptr;
+
+        if(message) {
+            stats.frame(size - buffer.size());
+            if(info.dropped_before != 0) { stats.dropped(info.dropped_before); }
+        } else {
+            stats.rejected();
+        }
+        if constexpr(Stats::timed) {
+            stats.time(ParseStage::format, formatTime);
+            stats.time(ParseStage::decode,
+                       std::chrono::steady_clock::now() - decodeStart - formatTime);
+        }
+        return {std::move(message), buffer, unparsed_bytes, info};
+    }
+}   // namespace detail
+
+// Same as parse, plus the FrameInfo of the frame, counting into stats.
+template<typename ErrorMessageF,
+         typename Stats>
+inline std::tuple<std::optional<std::string>,
+                  std::span<std::byte const>,
+                  std::size_t,
+                  FrameInfo>
+parseFrame(std::span<std::byte const>             buffer,
+           std::unordered_map<std::uint16_t,
+                              std::string> const& stringConstantsMap,
+           ErrorMessageF&&                        errorMessagef,
+           Stats&                                 stats) {
+    using Sink = detail::FrameSink<Stats, std::remove_reference_t<ErrorMessageF>>;
+    detail::Parser<Sink> parser{Sink{stats, errorMessagef}};
+    return detail::parseFrameWith(buffer, stringConstantsMap, parser, stats);
+}
+
+// Same as parse, plus the FrameInfo of the frame.
+template<typename ErrorMessageF>
+inline std::tuple<std::optional<std::string>,
+                  std::span<std::byte const>,
+                  std::size_t,
+                  FrameInfo>
+parseFrame(std::span<std::byte const>             buffer,
+           std::unordered_map<std::uint16_t,
+                              std::string> const& stringConstantsMap,
+           ErrorMessageF&&                        errorMessagef) {
+    NoStats stats{};
+    return parseFrame(buffer,
+                      stringConstantsMap,
+                      std::forward<ErrorMessageF>(errorMessagef),
+                      stats);
+}
+
+// Same as parse, plus the level of a message sent by a leveled print.
+template<typename ErrorMessageF>
+inline std::tuple<std::optional<std::string>,
+                  std::span<std::byte const>,
+                  std::size_t,
+                  std::optional<Level>>
+parseWithLevel(std::span<std::byte const>             buffer,
+               std::unordered_map<std::uint16_t,
+                                  std::string> const& stringConstantsMap,
+               ErrorMessageF&&                        errorMessagef) {
+    auto result
+      = parseFrame(buffer, stringConstantsMap, std::forward<ErrorMessageF>(errorMessagef));
+    return {std::move(std::get<0>(result)),
+            std::get<1>(result),
+            std::get<2>(result),
+            std::get<3>(result).level};
+}
+
+// Same as parse, counting into stats.
+template<typename ErrorMessageF,
+         typename Stats>
+inline std::tuple<std::optional<std::string>,
+                  std::span<std::byte const>,
+                  std::size_t>
+parse(std::span<std::byte const>             buffer,
+      std::unordered_map<std::uint16_t,
+                         std::string> const& stringConstantsMap,
+      ErrorMessageF&&                        errorMessagef,
+      Stats&                                 stats) {
+    auto result = parseFrame(buffer,
+                             stringConstantsMap,
+                             std::forward<ErrorMessageF>(errorMessagef),
+                             stats);
+    return {std::move(std::get<0>(result)), std::get<1>(result), std::get<2>(result)};
+}
+
 template<typename ErrorMessageF>
 inline std::tuple<std::optional<std::string>,
                   std::span<std::byte const>,
@@ -1220,45 +2564,55 @@ parse(std::span<std::byte const>             buffer,
       std::unordered_map<std::uint16_t,
                          std::string> const& stringConstantsMap,
       ErrorMessageF&&                        errorMessagef) {
-    std::size_t unparsed_bytes{};
-    while(!buffer.empty()) {
-        auto const        iterator = std::ranges::find(buffer, protocol::Start_marker);
-        std::size_t const offset
-          = static_cast<std::size_t>(std::distance(buffer.begin(), iterator));
-        buffer = buffer.subspan(offset);
-        unparsed_bytes += offset;
-        if(2 > buffer.size()
-           || detail::parseFmtStringTypeIdentifier(buffer[1], detail::FmtStringType::normal)
-           || detail::parseFmtStringTypeIdentifier(buffer[1],
-                                                   detail::FmtStringType::cataloged_normal))
-        {
-            break;
-        }
-        unparsed_bytes += 1;
-        buffer = buffer.subspan(1);
+    auto result
+      = parseFrame(buffer, stringConstantsMap, std::forward<ErrorMessageF>(errorMessagef));
+    return {std::move(std::get<0>(result)), std::get<1>(result), std::get<2>(result)};
+}
+
+// parse and parseFrame for a host that reads one stream for a long time: the error callback and
+// the stats are kept, and so is the decoder, instead of being set up again for every frame. It
+// points into itself, so it stays where it was made.
+template<typename ErrorMessageF,
+         typename Stats = NoStats>
+class FrameParser {
+public:
+    explicit FrameParser(ErrorMessageF errorMessagef_,
+                         Stats         stats_ = {})
+      : errorMessagef{std::move(errorMessagef_)}
+      , stats{std::move(stats_)} {}
+
+    FrameParser(FrameParser const&)            = delete;
+    FrameParser& operator=(FrameParser const&) = delete;
+
+    std::tuple<std::optional<std::string>,
+               std::span<std::byte const>,
+               std::size_t,
+               FrameInfo>
+    parseFrame(std::span<std::byte const>             buffer,
+               std::unordered_map<std::uint16_t,
+                                  std::string> const& stringConstantsMap) {
+        return detail::parseFrameWith(buffer, stringConstantsMap, parser, stats);
     }
 
-    bool const contains_end = std::ranges::find(buffer, protocol::End_marker) != buffer.end();
+    std::tuple<std::optional<std::string>,
+               std::span<std::byte const>,
+               std::size_t>
+    parse(std::span<std::byte const>             buffer,
+          std::unordered_map<std::uint16_t,
+                             std::string> const& stringConstantsMap) {
+        auto result = parseFrame(buffer, stringConstantsMap);
+        return {std::move(std::get<0>(result)), std::get<1>(result), std::get<2>(result)};
+    }
 
-    if(2 > buffer.size() || !contains_end) { return {std::nullopt, buffer, unparsed_bytes}; }
+    Stats const& get_stats() const { return stats; }
 
-    detail::FmtStringType const fmtStringType = [&]() {
-        if(detail::parseFmtStringTypeIdentifier(buffer[1], detail::FmtStringType::normal)) {
-            return detail::FmtStringType::normal;
-        }
-        return detail::FmtStringType::cataloged_normal;
-    }();
+    Stats& get_stats() { return stats; }
 
-    detail::Parser parser{std::forward<ErrorMessageF>(errorMessagef)};
-    auto const     optionalStr
-      = parser.parseFmt(std::next(buffer.begin()), buffer.end(), fmtStringType, stringConstantsMap);
+private:
+    using Sink = detail::FrameSink<Stats, ErrorMessageF>;
 
-    if(!optionalStr) { return {std::nullopt, buffer, unparsed_bytes}; }
-    if(optionalStr->pos == buffer.end() || *optionalStr->pos != protocol::End_marker) {
-        return {std::nullopt, buffer, unparsed_bytes};
-    }
-    buffer = buffer.subspan(
-      static_cast<std::size_t>(std::distance(buffer.begin(), optionalStr->pos + 1)));
-    return {optionalStr->str, buffer, unparsed_bytes};
-}
+    ErrorMessageF        errorMessagef;
+    Stats                stats;
+    detail::Parser<Sink> parser{Sink{stats, errorMessagef}};
+};
 }   // namespace remote_fmt
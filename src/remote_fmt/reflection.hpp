@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace remote_fmt { namespace detail {
+
+    // What an aggregate of scalars can be walked with: its field count, references to its fields
+    // and, where the compiler allows it, their names. Fields are found by aggregate initialization
+    // and structured bindings, so bases, bit-fields and more than max_aggregate_fields fields are
+    // not supported.
+    inline constexpr std::size_t max_aggregate_fields = 16;
+
+    // Converts to any scalar type, or to anything at all. A field that is not a scalar stops the
+    // count of ScalarField but not that of AnyField, which tells the two kinds of aggregate apart.
+    struct ScalarField {
+        template<typename T>
+            requires std::is_scalar_v<T>
+        constexpr operator T() const;
+    };
+
+    struct AnyField {
+        template<typename T>
+        constexpr operator T() const;
+    };
+
+    template<typename T,
+             typename Field,
+             std::size_t... Is>
+    consteval bool initializableFrom(std::index_sequence<Is...>) {
+        return requires { T{(static_cast<void>(Is), Field{})...}; };
+    }
+
+    // The most fields T is initializable from, or 0 past max_aggregate_fields.
+    template<typename T,
+             typename Field>
+    consteval std::size_t initializerCount() {
+        if constexpr(initializableFrom<T, Field>(
+                       std::make_index_sequence<max_aggregate_fields + 1>{}))
+        {
+            return 0;
+        } else {
+            return []<std::size_t... Ns>(std::index_sequence<Ns...>) {
+                std::size_t count = 0;
+                (void)((initializableFrom<T, Field>(std::make_index_sequence<Ns>{})
+                        && (count = Ns, true))
+                       && ...);
+                return count;
+            }(std::make_index_sequence<max_aggregate_fields + 1>{});
+        }
+    }
+
+    // Number of fields of an aggregate whose fields are all scalars, 0 for any other type.
+    template<typename T>
+    consteval std::size_t scalarFieldCount() {
+        if constexpr(!std::is_aggregate_v<T> || std::is_array_v<T>) {
+            return 0;
+        } else {
+            constexpr std::size_t count = initializerCount<T, ScalarField>();
+            return count == initializerCount<T, AnyField>() ? count : 0;
+        }
+    }
+
+    template<typename T>
+    inline constexpr std::size_t scalar_field_count = scalarFieldCount<T>();
+
+    // Written out per count: a structured binding cannot take a pack before C++26.
+    template<typename T>
+    constexpr auto tieFields(T const& value) {
+        constexpr std::size_t count = scalar_field_count<T>;
+        static_assert(count != 0 && count <= max_aggregate_fields);
+        if constexpr(count == 1) {
+            auto const& [f0] = value;
+            return std::tie(f0);
+        } else if constexpr(count == 2) {
+            auto const& [f0, f1] = value;
+            return std::tie(f0, f1);
+        } else if constexpr(count == 3) {
+            auto const& [f0, f1, f2] = value;
+            return std::tie(f0, f1, f2);
+        } else if constexpr(count == 4) {
+            auto const& [f0, f1, f2, f3] = value;
+            return std::tie(f0, f1, f2, f3);
+        } else if constexpr(count == 5) {
+            auto const& [f0, f1, f2, f3, f4] = value;
+            return std::tie(f0, f1, f2, f3, f4);
+        } else if constexpr(count == 6) {
+            auto const& [f0, f1, f2, f3, f4, f5] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5);
+        } else if constexpr(count == 7) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6);
+        } else if constexpr(count == 8) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+        } else if constexpr(count == 9) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+        } else if constexpr(count == 10) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+        } else if constexpr(count == 11) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+        } else if constexpr(count == 12) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+        } else if constexpr(count == 13) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+        } else if constexpr(count == 14) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+        } else if constexpr(count == 15) {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+        } else {
+            auto const& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15]
+              = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+        }
+    }
+
+    template<typename T,
+             std::size_t I>
+    using field_t = std::remove_cvref_t<
+      std::tuple_element_t<I, decltype(tieFields(std::declval<T const&>()))>>;
+
+#if __cpp_nontype_template_args >= 201911L && (defined(__GNUC__) || defined(__clang__))
+    // Declared only. Its fields' addresses are template arguments, whose spelling in the function
+    // signature ends in the field name: "(& field_probe<S>.S::name)]" for gcc, "&field_probe<S>.name]"
+    // for clang.
+    template<typename T>
+    extern T const field_probe;
+
+    template<auto Field>
+    consteval char const* fieldSignature() {
+        return __PRETTY_FUNCTION__;
+    }
+
+    consteval std::string_view trailingIdentifier(std::string_view signature) {
+        while(!signature.empty() && (signature.back() == ']' || signature.back() == ')')) {
+            signature.remove_suffix(1);
+        }
+        auto const start = signature.find_last_not_of(
+          "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_");
+        return signature.substr(start + 1);
+    }
+
+    #ifdef __clang__
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wundefined-var-template"
+    #endif
+    template<typename T,
+             std::size_t I>
+    consteval std::string_view fieldName() {
+        return trailingIdentifier(fieldSignature<&std::get<I>(tieFields(field_probe<T>))>());
+    }
+    #ifdef __clang__
+        #pragma clang diagnostic pop
+    #endif
+#else
+    // Without names the fields go by their position.
+    template<typename T,
+             std::size_t I>
+    consteval std::string_view fieldName() {
+        constexpr std::string_view positions = "0123456789101112131415";
+        return I < 10 ? positions.substr(I, 1) : positions.substr(10 + ((I - 10) * 2), 2);
+    }
+#endif
+}}   // namespace remote_fmt::detail
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "c_printer.h"
+#include "call_site_command.hpp"
 #include "catalog.hpp"
+#include "reflection.hpp"
 #include "type_identifier.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
 #include <chrono>
 #include <concepts>
@@ -113,6 +118,82 @@ static constexpr bool use_catalog = true;
 static constexpr bool use_catalog{REMOTE_FMT_USE_CATALOG};
 #endif
 
+enum class Level : std::uint8_t { trace, debug, info, warning, error, critical };
+
+// Leveled prints below this are compiled out entirely. Takes a Level or its numeric value.
+#ifndef REMOTE_FMT_MIN_LEVEL
+static constexpr Level min_level = Level::trace;
+#else
+static constexpr Level min_level{REMOTE_FMT_MIN_LEVEL};
+#endif
+
+// Per-module threshold: print<level, Tag> is compiled out below tag_min_level<Tag>. Specialize
+// it for a tag type to raise or lower one module against min_level.
+template<typename Tag>
+constexpr Level tag_min_level = min_level;
+
+// Catalog ids below this get a bit in the run-time enable bitmap of Printer, which the host
+// flips with call site commands. 0 leaves the bitmap and its check out. Catalog mode only.
+#ifndef REMOTE_FMT_CALL_SITE_SLOTS
+static constexpr std::size_t call_site_slots = 0;
+#else
+static constexpr std::size_t call_site_slots{REMOTE_FMT_CALL_SITE_SLOTS};
+#endif
+
+// Bytes of stack a range that does not know its size is serialized into before it is sent, so
+// that it is only walked once: its count goes ahead of the elements. A range that does not fit is
+// walked twice instead, once to count it. 0 always walks twice.
+#ifndef REMOTE_FMT_RANGE_STAGING_SIZE
+static constexpr std::size_t range_staging_size = 128;
+#else
+static constexpr std::size_t range_staging_size{REMOTE_FMT_RANGE_STAGING_SIZE};
+#endif
+
+namespace detail {
+    // The frames a Printer with a reserving backend has dropped since its last frame went out.
+    // Copying or moving the Printer takes the count along, which std::atomic alone would not.
+    class DropCounter {
+    public:
+        DropCounter() = default;
+
+        DropCounter(DropCounter const& other) : count{other.load()} {}
+
+        DropCounter& operator=(DropCounter const& other) {
+            count.store(other.load(), std::memory_order_relaxed);
+            return *this;
+        }
+
+        std::uint32_t load() const { return count.load(std::memory_order_relaxed); }
+
+        // The count, which is then 0.
+        std::uint32_t take() { return count.exchange(0, std::memory_order_relaxed); }
+
+        void add(std::uint32_t frames) { count.fetch_add(frames, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<std::uint32_t> count{};
+    };
+
+    // In place of a DropCounter for a backend without reserve, which never drops a frame.
+    struct NoDropCounter {};
+}   // namespace detail
+
+// Printer policy that sends every frame.
+struct NoRepeatFilter {};
+
+template<typename ComBackend,
+         typename RepeatPolicy = NoRepeatFilter>
+struct Printer;
+
+// Trades a little speed for code size: print passes a table describing its argument types and
+// pointers to the arguments to one out-of-line encoder, instead of getting a serializer of its
+// own for every combination of format string and argument types. Same bytes on the wire.
+#ifndef REMOTE_FMT_TYPE_ERASED
+static constexpr bool type_erased = false;
+#else
+static constexpr bool type_erased{REMOTE_FMT_TYPE_ERASED};
+#endif
+
 namespace detail {
 
     template<FmtStringType T>
@@ -179,6 +260,28 @@ namespace detail {
         return std::ranges::all_of(stringView, isValidChar);
     }
 
+    // A leveled print puts its level in front of the format string as one control character.
+    // isValidChar rejects those everywhere else, so the prefix cannot be mistaken for text, and in
+    // catalog mode it lives in the catalog entry instead of on the wire.
+    static constexpr char Level_prefix_base{0x10};
+
+    template<Level level,
+             char... chars>
+    consteval auto withLevelPrefix(sc::StringConstant<chars...>) {
+        return sc::StringConstant<static_cast<char>(Level_prefix_base
+                                                    + static_cast<char>(level)),
+                                  chars...>{};
+    }
+
+    constexpr std::optional<Level> levelFromPrefix(std::string_view stringView) {
+        if(stringView.empty() || stringView.front() < Level_prefix_base
+           || stringView.front() > Level_prefix_base + static_cast<char>(Level::critical))
+        {
+            return std::nullopt;
+        }
+        return static_cast<Level>(stringView.front() - Level_prefix_base);
+    }
+
     // A replacement field carrying no format spec at all. fmt applies its debug format to strings
     // and chars nested inside a range or tuple only while the spec is absent - an explicit spec
     // replaces it - so the parser has to distinguish this exact field from every other one.
@@ -296,6 +399,25 @@ namespace detail {
         return true;
     }
 
+    // replacementFieldWithinLimits for every field. A format string known at compile time is
+    // trusted; one that arrives at run time is refused on the device rather than by the host.
+    constexpr bool fieldsWithinLimits(std::string_view stringView) {
+        for(std::size_t index = 0; index < stringView.size(); ++index) {
+            if(stringView[index] != '{') { continue; }
+            if(index + 1 < stringView.size() && stringView[index + 1] == '{') {
+                ++index;   // an escaped brace, not a field
+                continue;
+            }
+            auto const close = stringView.find('}', index);
+            if(close == std::string_view::npos) { return false; }
+            if(!replacementFieldWithinLimits(stringView.substr(index, close - index + 1))) {
+                return false;
+            }
+            index = close;
+        }
+        return true;
+    }
+
 }   // namespace detail
 
 }   // namespace remote_fmt
@@ -308,9 +430,9 @@ namespace remote_fmt {
 template<typename... Args,
          char... chars>
 consteval void checkFormatString(sc::StringConstant<chars...>) {
-    detail::compile_time_assert(
-      "invalid chars in format",
-      detail::allCharsValid(std::string_view{sc::StringConstant<chars...>{}}));
+    detail::compile_time_assert("invalid chars in format",
+                                detail::allCharsValid(
+                                  std::string_view{sc::StringConstant<chars...>{}}));
     detail::compile_time_assert("invalid replacement field count",
                                 detail::is_arg_count_valid<sizeof...(Args)>(
                                   std::string_view{sc::StringConstant<chars...>{}}));
@@ -320,9 +442,41 @@ consteval void checkFormatString(sc::StringConstant<chars...>) {
     detail::checkFormatStringWithFmt<Args...>(sc::StringConstant<chars...>{});
 }
 
+namespace detail {
+    // checkFormatString, run once per format string and argument types. A variable template is
+    // instantiated once; a consteval call inside a function template runs again in every
+    // instantiation, and print, format, format_to and staticPrint, each with every reference
+    // category of its arguments, are separate instantiations.
+    template<typename FmtString,
+             typename... Args>
+    inline constexpr bool format_string_checked = (checkFormatString<Args...>(FmtString{}), true);
+}   // namespace detail
+
 template<typename T>
 struct formatter;
 
+namespace detail {
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    consteval std::byte arithmeticTypeIdentifier() {
+        constexpr auto typeSize    = typeToTypeSize<T>();
+        constexpr auto trivialType = []() constexpr {
+            if constexpr(std::is_same_v<bool, T>) {
+                return TrivialType::boolean;
+            } else if constexpr(std::is_same_v<char, T>) {
+                return TrivialType::character;
+            } else if constexpr(std::is_floating_point_v<T>) {
+                return TrivialType::floatingpoint;
+            } else if constexpr(std::is_signed_v<T>) {
+                return TrivialType::signed_;
+            } else {
+                return TrivialType::unsigned_;
+            }
+        }();
+        return trivialTypeIdentifier<trivialType, typeSize>();
+    }
+}   // namespace detail
+
 template<std::integral T>
 struct formatter<T> {
     template<typename Printer>
@@ -331,19 +485,7 @@ struct formatter<T> {
         static_assert(8 >= sizeof(value), "bad type: no [u]int128_t");
         static_assert(1 == sizeof(char), "bad type: only 1 byte char");
 
-        constexpr auto typeSize    = detail::typeToTypeSize<T>();
-        constexpr auto trivialType = []() constexpr {
-            if constexpr(std::is_same_v<bool, T>) {
-                return detail::TrivialType::boolean;
-            } else if constexpr(std::is_same_v<char, T>) {
-                return detail::TrivialType::character;
-            } else if constexpr(std::is_signed_v<T>) {
-                return detail::TrivialType::signed_;
-            } else {
-                return detail::TrivialType::unsigned_;
-            }
-        }();
-        constexpr auto typeIdentifier = detail::trivialTypeIdentifier<trivialType, typeSize>();
+        constexpr auto typeIdentifier = detail::arithmeticTypeIdentifier<T>();
 
         printer.printHelper(typeIdentifier, value);
     }
@@ -359,9 +501,7 @@ struct formatter<T> {
         static_assert(4 == sizeof(float), "bad type: float");
         static_assert(8 == sizeof(double), "bad type: double");
 
-        constexpr auto typeSize = detail::typeToTypeSize<T>();
-        constexpr auto typeIdentifier
-          = detail::trivialTypeIdentifier<detail::TrivialType::floatingpoint, typeSize>();
+        constexpr auto typeIdentifier = detail::arithmeticTypeIdentifier<T>();
 
         printer.printHelper(typeIdentifier, value);
     }
@@ -387,6 +527,33 @@ struct formatter<T> {
 
 namespace detail {
 
+    // Everything of a time value but its count: the identifier and the period.
+    template<TimeType      timeType,
+             std::intmax_t numerator,
+             std::intmax_t denominator,
+             typename Append>
+    constexpr void appendTimeHeader(TimeRepresentation timeRep,
+                                    Append             append) {
+        // A period the parser knows by index goes out as one byte. Only a custom ratio still
+        // spells out numerator and denominator.
+        constexpr auto ratioIndex = detail::stdRatioIndex<numerator, denominator>();
+        if constexpr(ratioIndex) {
+            append(detail::stdRatioTimeTypeIdentifier<timeType>(timeRep), *ratioIndex);
+        } else {
+            constexpr auto numerator_size
+              = (numerator <= 255) ? NumeratorSize::_1 : NumeratorSize::_8;
+            constexpr auto denominator_size
+              = sizeToTypeSize(static_cast<std::uint64_t>(denominator));
+
+            auto const typeIdentifier
+              = detail::timeTypeIdentifier<timeType, numerator_size, denominator_size>(timeRep);
+
+            append(typeIdentifier,
+                   static_cast<detail::numeratorSize_unsigned_t<numerator_size>>(numerator),
+                   static_cast<detail::typeSize_unsigned_t<denominator_size>>(denominator));
+        }
+    }
+
     template<TimeType timeType,
              typename Rep,
              std::intmax_t Num,
@@ -409,18 +576,10 @@ namespace detail {
         static_assert(numerator > 0, "should not be possible std::chrono::duration checks that");
         static_assert(denominator > 0, "should not be possible std::chrono::duration checks that");
 
-        constexpr auto numerator_size = (numerator <= 255) ? NumeratorSize::_1 : NumeratorSize::_8;
-        constexpr auto denominator_size = sizeToTypeSize(static_cast<std::uint64_t>(denominator));
-
         auto const count   = duration.count();
         auto const timeRep = detail::repForValue(count);
-        auto const typeIdentifier
-          = detail::timeTypeIdentifier<timeType, numerator_size, denominator_size>(timeRep);
-
-        append(typeIdentifier,
-               static_cast<detail::numeratorSize_unsigned_t<numerator_size>>(numerator),
-               static_cast<detail::typeSize_unsigned_t<denominator_size>>(denominator));
 
+        appendTimeHeader<timeType, numerator, denominator>(timeRep, append);
         appendSized(timeRep, count, append);
     }
 }   // namespace detail
@@ -485,33 +644,44 @@ struct formatter<T> {
     }
 };
 
-template<char... chars>
-struct formatter<sc::StringConstant<chars...>> {
-    template<typename Printer>
-    constexpr auto format(sc::StringConstant<chars...> const& value,
-                          Printer&                            printer) const {
+namespace detail {
+    // A StringConstant as a string element: its catalog id, or the text itself.
+    template<char... chars,
+             typename Append>
+    constexpr void appendStringConstant(sc::StringConstant<chars...> const& value,
+                                        Append                              append) {
         if constexpr(use_catalog) {
-            auto constexpr rangeSize
-              = detail::sizeToRangeSize(std::numeric_limits<std::uint16_t>::max());
-            auto constexpr typeIdentifier
-              = detail::rangeTypeIdentifier<detail::RangeType::cataloged_string,
-                                            detail::RangeLayout::compact>(rangeSize);
-
-            printer.printHelper(typeIdentifier);
+            auto constexpr rangeSize = sizeToRangeSize(std::numeric_limits<std::uint16_t>::max());
+            append(
+              rangeTypeIdentifier<RangeType::cataloged_string, RangeLayout::compact>(rangeSize));
 #ifdef __clang__
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wundefined-func-template"
 #endif
-            appendSized(rangeSize, catalog<decltype(value)>(), [&](auto const&... valueArgs) {
-                printer.printHelper(valueArgs...);
-            });
+            appendSized(rangeSize, catalog<decltype(value)>(), append);
 #ifdef __clang__
     #pragma clang diagnostic pop
 #endif
         } else {
-            formatter<std::string_view>{}.format(std::string_view{value}, printer);
+            auto constexpr rangeSize = sizeToRangeSize(sizeof...(chars));
+            append(rangeTypeIdentifier<RangeType::string, RangeLayout::compact>(rangeSize),
+                   static_cast<rangeSize_unsigned_t<rangeSize>>(sizeof...(chars)));
+            if constexpr(sizeof...(chars) != 0) {
+                append(std::array<char, sizeof...(chars)>{chars...});
+            }
         }
     }
+}   // namespace detail
+
+template<char... chars>
+struct formatter<sc::StringConstant<chars...>> {
+    template<typename Printer>
+    constexpr auto format(sc::StringConstant<chars...> const& value,
+                          Printer&                            printer) const {
+        detail::appendStringConstant(value, [&](auto const&... valueArgs) {
+            printer.printHelper(valueArgs...);
+        });
+    }
 };
 
 // Formatters are looked up via remove_cvref_t, which also strips the element const from a
@@ -525,6 +695,50 @@ struct formatter<char[N]> {
     }
 };
 
+namespace detail {
+    // An enum is sent as its underlying integer wherever it has no names to send.
+    template<typename E>
+    using enum_wire_t = std::conditional_t<
+      std::is_same_v<std::underlying_type_t<E>, char>,
+      std::conditional_t<std::is_unsigned_v<char>, std::uint8_t, std::int8_t>,
+      std::underlying_type_t<E>>;
+}   // namespace detail
+
+#if __has_include(<enchantum/enchantum.hpp>)
+namespace detail {
+    // All enumerator names of E in enchantum::values order, comma separated. The catalog generator
+    // splits them again and gives each name its own id, one after the other, so the id of a value
+    // is the id of the table plus its index.
+    template<typename E>
+    struct EnumNameTable {
+        static constexpr auto joined = []() {
+            constexpr std::size_t size = []() {
+                std::size_t length = 0;
+                for(auto const value : enchantum::values<E>) {
+                    length += enchantum::to_string(value).size() + 1;
+                }
+                return length == 0 ? 0 : length - 1;
+            }();
+
+            std::array<char, size> names{};
+            std::size_t            position = 0;
+            for(auto const value : enchantum::values<E>) {
+                if(position != 0) { names[position++] = ','; }
+                for(char const character : enchantum::to_string(value)) {
+                    names[position++] = character;
+                }
+            }
+            return names;
+        }();
+
+        static constexpr auto names
+          = sc::create([]() { return std::string_view{joined.data(), joined.size()}; });
+
+        using catalog_key = EnumNames<std::remove_cvref_t<decltype(names)>>;
+    };
+}   // namespace detail
+#endif
+
 template<typename T>
     requires std::is_enum_v<T> && (!std::is_same_v<std::byte, T>)
 struct formatter<T> {
@@ -532,26 +746,35 @@ struct formatter<T> {
     constexpr auto format(T const& value,
                           Printer& printer) const {
         auto as_int = [&]() {
-            using underlying_t = std::underlying_type_t<T>;
-
-            using format_t = std::conditional_t<
-              std::is_same_v<underlying_t, char>,
-              std::conditional_t<std::is_unsigned_v<underlying_t>, std::uint8_t, std::int8_t>,
-              underlying_t>;
-
+            using format_t = detail::enum_wire_t<T>;
             return formatter<format_t>{}.format(static_cast<format_t>(value), printer);
         };
 #if __has_include(<enchantum/enchantum.hpp>)
-        if(enchantum::contains(value)) {
-            enchantum_ext::enum_switch(value, [&](auto enumValue) {
-                static constexpr T    enumConstant = enumValue;
-                static constexpr auto get
-                  = sc::create([]() { return enchantum::to_string(enumConstant); });
-                formatter<std::remove_cvref_t<decltype(get)>>{}.format(get, printer);
+        auto const index = enchantum::enum_to_index(value);
+        if(!index) { return as_int(); }
+
+        if constexpr(use_catalog) {
+            // One id per enumerator, so the value goes out like any other cataloged string - in
+            // a single byte when the id is small enough, which the generator arranges by numbering
+            // the enum tables first.
+    #ifdef __clang__
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wundefined-func-template"
+    #endif
+            auto const id = static_cast<std::uint16_t>(
+              catalog<typename detail::EnumNameTable<T>::catalog_key>() + *index);
+    #ifdef __clang__
+        #pragma clang diagnostic pop
+    #endif
+            auto const rangeSize = detail::sizeToRangeSize(id);
+            printer.printHelper(
+              detail::rangeTypeIdentifier<detail::RangeType::cataloged_string,
+                                          detail::RangeLayout::compact>(rangeSize));
+            appendSized(rangeSize, id, [&](auto const&... valueArgs) {
+                printer.printHelper(valueArgs...);
             });
-            return;
         } else {
-            return as_int();
+            formatter<std::string_view>{}.format(enchantum::to_string(value), printer);
         }
 #else
         return as_int();
@@ -559,42 +782,372 @@ struct formatter<T> {
     }
 };
 
-template<detail::is_range_but_not_string_like T>
-struct formatter<T> {
-private:
-    template<typename R,
-             typename Printer>
-    static constexpr void formatImpl(R&          range,
-                                     std::size_t size,
-                                     Printer&    printer) {
-        auto constexpr rangeType = []() constexpr {
-            if constexpr(detail::is_map<T>) {
-                return detail::RangeType::map;
-            } else if constexpr(detail::is_set<T>) {
-                return detail::RangeType::set;
+namespace detail {
+    // Element types whose identifiers can be sent once for a whole range: the bytes ahead of each
+    // payload depend only on the type and on a State gathered over all elements first. A range of
+    // these uses RangeLayout::compact - the schema ahead of the first element, then nothing but
+    // payloads. For an integral or floating point element the schema is the one trivial identifier
+    // the compact layout has always carried. Where bytewise says the payloads are the elements' own
+    // object bytes, a contiguous range goes out in a single copy.
+    template<typename T>
+    struct Schema {
+        static constexpr bool fixed = false;
+    };
+
+    template<typename T>
+        requires((std::is_arithmetic_v<T> || std::is_same_v<std::byte, T>) && 8 >= sizeof(T))
+    struct Schema<T> {
+        using wire_t = std::conditional_t<std::is_same_v<std::byte, T>, std::uint8_t, T>;
+
+        static constexpr bool fixed = true;
+
+        struct State {};
+
+        static constexpr State initial() { return {}; }
+
+        static constexpr void widen(State&,
+                                    T const&) {}
+
+        static constexpr bool bytewise(State const&) { return true; }
+
+        template<typename Append>
+        static constexpr void header(State const&,
+                                     Append append) {
+            append(arithmeticTypeIdentifier<wire_t>());
+        }
+
+        template<typename Append>
+        static constexpr void payload(State const&,
+                                      T const& value,
+                                      Append   append) {
+            append(static_cast<wire_t>(value));
+        }
+    };
+
+    template<typename T>
+        requires(std::is_same_v<T, void*> || std::is_same_v<T, void const*>)
+             && (sizeof(std::uintptr_t) == sizeof(T))
+    struct Schema<T> {
+        static constexpr bool fixed = true;
+
+        struct State {};
+
+        static constexpr State initial() { return {}; }
+
+        static constexpr void widen(State&,
+                                    T const&) {}
+
+        static constexpr bool bytewise(State const&) { return true; }
+
+        template<typename Append>
+        static constexpr void header(State const&,
+                                     Append append) {
+            append(trivialTypeIdentifier<TrivialType::pointer, typeToTypeSize<std::uintptr_t>()>());
+        }
+
+        template<typename Append>
+        static constexpr void payload(State const&,
+                                      T const& value,
+                                      Append   append) {
+            append(std::bit_cast<std::uintptr_t>(value));
+        }
+    };
+
+#if __has_include(<enchantum/enchantum.hpp>)
+    // Names are only sent for an enum whose enumerators are 0, 1, 2, ... in order: there the
+    // value is the index into the table and can be copied as it is.
+    template<typename E>
+    consteval bool enumIsDense() {
+        std::size_t index = 0;
+        for(auto const value : enchantum::values<E>) {
+            if(static_cast<std::underlying_type_t<E>>(value)
+               != static_cast<std::underlying_type_t<E>>(index))
+            {
+                return false;
+            }
+            ++index;
+        }
+        return index != 0 && index <= std::numeric_limits<std::uint16_t>::max();
+    }
+
+    // The header names the index type, the number of names and the table: its catalog id, or the
+    // names themselves comma separated. A value outside the table is printed as a number.
+    template<typename E>
+        requires std::is_enum_v<E> && (!std::is_same_v<std::byte, E>) && (enumIsDense<E>())
+    struct Schema<E> {
+        static constexpr bool fixed = true;
+
+        struct State {};
+
+        static constexpr State initial() { return {}; }
+
+        static constexpr void widen(State&,
+                                    E const&) {}
+
+        static constexpr bool bytewise(State const&) { return true; }
+
+        template<typename Append>
+        static constexpr void header(State const&,
+                                     Append append) {
+            using table = EnumNameTable<E>;
+            appendExtendedTypeIdentifier<ExtendedTypeIdentifier::enumeration>(append);
+            append(arithmeticTypeIdentifier<enum_wire_t<E>>(),
+                   static_cast<std::uint16_t>(enchantum::count<E>));
+            if constexpr(use_catalog) {
+    #ifdef __clang__
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wundefined-func-template"
+    #endif
+                auto const id        = catalog<typename table::catalog_key>();
+    #ifdef __clang__
+        #pragma clang diagnostic pop
+    #endif
+                auto const rangeSize = sizeToRangeSize(id);
+                append(rangeTypeIdentifier<RangeType::cataloged_string, RangeLayout::compact>(
+                  rangeSize));
+                appendSized(rangeSize, id, append);
             } else {
-                return detail::RangeType::list;
+                constexpr auto rangeSize = sizeToRangeSize(table::joined.size());
+                append(rangeTypeIdentifier<RangeType::string, RangeLayout::compact>(rangeSize),
+                       static_cast<rangeSize_unsigned_t<rangeSize>>(table::joined.size()),
+                       table::joined);
             }
-        }();
+        }
+
+        template<typename Append>
+        static constexpr void payload(State const&,
+                                      E const& value,
+                                      Append   append) {
+            append(static_cast<enum_wire_t<E>>(value));
+        }
+    };
+#else
+    template<typename E>
+        requires std::is_enum_v<E> && (!std::is_same_v<std::byte, E>)
+    struct Schema<E> : Schema<enum_wire_t<E>> {
+        static constexpr void widen(typename Schema<enum_wire_t<E>>::State&,
+                                    E const&) {}
+
+        template<typename Append>
+        static constexpr void payload(typename Schema<enum_wire_t<E>>::State const&,
+                                      E const& value,
+                                      Append   append) {
+            append(static_cast<enum_wire_t<E>>(value));
+        }
+    };
+#endif
 
-        constexpr bool is_contiguous         = std::ranges::contiguous_range<T>;
-        using value_t                        = std::ranges::range_value_t<T>;
-        constexpr bool is_trivial_formatable = std::is_integral_v<value_t>
-                                            || std::is_floating_point_v<value_t>
-                                            || std::is_same_v<std::byte, value_t>;
+    // The representation is the narrowest that holds every count in the range, so a range of
+    // small millisecond values still sends four bytes per element.
+    template<TimeType timeType,
+             typename Rep,
+             typename Period>
+    struct TimeSchema {
+        using duration_t = std::chrono::duration<Rep, Period>;
+
+        static constexpr bool fixed = true;
+
+        using State = TimeRepresentation;
+
+        static constexpr State initial() {
+            return std::is_floating_point_v<Rep> ? repForValue(Rep{}) : TimeRepresentation::_int32;
+        }
+
+        static constexpr void widen(State&            state,
+                                    duration_t const& duration) {
+            if(repForValue(duration.count()) == TimeRepresentation::_int64) {
+                state = TimeRepresentation::_int64;
+            }
+        }
+
+        // Only when the representation is the count type itself, so a range of int64 counts that
+        // all fit into int32 is still narrowed element by element rather than copied.
+        static constexpr bool bytewise(State const& state) {
+            switch(state) {
+            case TimeRepresentation::_int32:
+                return std::is_integral_v<Rep> && std::is_signed_v<Rep> && sizeof(Rep) == 4;
+            case TimeRepresentation::_int64:
+                return std::is_integral_v<Rep> && std::is_signed_v<Rep> && sizeof(Rep) == 8;
+            case TimeRepresentation::_float: return std::is_same_v<Rep, float>;
+            case TimeRepresentation::_double: return std::is_same_v<Rep, double>;
+            }
+            return false;
+        }
+
+        template<typename Append>
+        static constexpr void header(State const& state,
+                                     Append       append) {
+            appendTimeHeader<timeType, Period::num, Period::den>(state, append);
+        }
+
+        template<typename Append>
+        static constexpr void payload(State const&      state,
+                                      duration_t const& duration,
+                                      Append            append) {
+            appendSized(state, duration.count(), append);
+        }
+    };
+
+    template<typename Rep, typename Period>
+        requires std::is_arithmetic_v<Rep>
+    struct Schema<std::chrono::duration<Rep, Period>>
+      : TimeSchema<TimeType::duration, Rep, Period> {};
+
+    template<typename Clock, typename Duration>
+        requires std::is_arithmetic_v<typename Duration::rep>
+    struct Schema<std::chrono::time_point<Clock, Duration>>
+      : TimeSchema<TimeType::time_point, typename Duration::rep, typename Duration::period> {
+        using base
+          = TimeSchema<TimeType::time_point, typename Duration::rep, typename Duration::period>;
+        using time_point_t = std::chrono::time_point<Clock, Duration>;
+
+        static constexpr void widen(typename base::State& state,
+                                    time_point_t const&   timePoint) {
+            base::widen(state, timePoint.time_since_epoch());
+        }
+
+        template<typename Append>
+        static constexpr void payload(typename base::State const& state,
+                                      time_point_t const&         timePoint,
+                                      Append                      append) {
+            base::payload(state, timePoint.time_since_epoch(), append);
+        }
+    };
+
+    template<typename T>
+    consteval bool tupleHasFixedSchema() {
+        return []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (Schema<std::remove_cvref_t<std::tuple_element_t<Is, T>>>::fixed && ...);
+        }(std::make_index_sequence<std::tuple_size_v<T>>{});
+    }
+
+    // The tuple header, then the schema of each element in turn; the payload is the element
+    // payloads back to back.
+    template<is_tuple_like_but_not_range T>
+        requires(tupleHasFixedSchema<T>())
+    struct Schema<T> {
+        template<std::size_t I>
+        using element_schema = Schema<std::remove_cvref_t<std::tuple_element_t<I, T>>>;
+
+        using index_sequence = std::make_index_sequence<std::tuple_size_v<T>>;
+
+        static constexpr bool fixed = true;
+
+        using State = decltype([]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::tuple<typename element_schema<Is>::State...>{};
+        }(index_sequence{}));
+
+        static constexpr State initial() {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return State{element_schema<Is>::initial()...};
+            }(index_sequence{});
+        }
+
+        static constexpr void widen(State&   state,
+                                    T const& tuple) {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                using std::get;
+                (element_schema<Is>::widen(std::get<Is>(state), get<Is>(tuple)), ...);
+            }(index_sequence{});
+        }
+
+        // The standard library does not promise a tuple's element order in memory.
+        static constexpr bool bytewise(State const&) { return false; }
+
+        template<typename Append>
+        static constexpr void header(State const& state,
+                                     Append       append) {
+            constexpr auto rangeSize = sizeToRangeSize(std::tuple_size_v<T>);
+            append(rangeTypeIdentifier<RangeType::tuple, RangeLayout::on_ti_each>(rangeSize),
+                   static_cast<rangeSize_unsigned_t<rangeSize>>(std::tuple_size_v<T>));
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (element_schema<Is>::header(std::get<Is>(state), append), ...);
+            }(index_sequence{});
+        }
+
+        template<typename Append>
+        static constexpr void payload(State const& state,
+                                      T const&     tuple,
+                                      Append       append) {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                using std::get;
+                (element_schema<Is>::payload(std::get<Is>(state), get<Is>(tuple), append), ...);
+            }(index_sequence{});
+        }
+    };
+}   // namespace detail
+
+namespace detail {
+    // Collects the bytes of a range up to Capacity; past that it only notes that they did not fit.
+    template<std::size_t Capacity>
+    struct StagingBackend {
+        std::array<std::byte, Capacity> bytes;
+        std::size_t                      size{};
+        bool                             overflowed{};
+
+        // User-provided so that the Printer's value-initialization does not clear bytes first.
+        constexpr StagingBackend() {}
+
+        constexpr void write(std::span<std::byte const> data) {
+            if(overflowed || data.size() > Capacity - size) {
+                overflowed = true;
+                return;
+            }
+            std::ranges::copy(data, bytes.begin() + static_cast<std::ptrdiff_t>(size));
+            size += data.size();
+        }
+
+        constexpr std::span<std::byte const> staged() const { return {bytes.data(), size}; }
+    };
+}   // namespace detail
 
+template<detail::is_range_but_not_string_like T>
+struct formatter<T> {
+private:
+    static constexpr auto rangeType = []() constexpr {
+        if constexpr(detail::is_map<T>) {
+            return detail::RangeType::map;
+        } else if constexpr(detail::is_set<T>) {
+            return detail::RangeType::set;
+        } else {
+            return detail::RangeType::list;
+        }
+    }();
+
+    static constexpr bool is_contiguous         = std::ranges::contiguous_range<T>;
+    using value_t                               = std::ranges::range_value_t<T>;
+    static constexpr bool is_trivial_formatable = std::is_integral_v<value_t>
+                                               || std::is_floating_point_v<value_t>
+                                               || std::is_same_v<std::byte, value_t>;
+    // Gathering the State walks the range once before sending it. For most schemas there is
+    // nothing to gather and the walk compiles away.
+    static constexpr bool has_fixed_schema = !is_trivial_formatable
+                                          && detail::Schema<value_t>::fixed
+                                          && std::ranges::forward_range<T>;
+
+    template<typename Printer>
+    static constexpr void formatHeader(std::size_t size,
+                                       Printer&    printer) {
         auto const rangeSize = detail::sizeToRangeSize(size);
         auto const typeIdentifier
           = detail::rangeTypeIdentifier<rangeType,
-                                        is_trivial_formatable ? detail::RangeLayout::compact
-                                                              : detail::RangeLayout::on_ti_each>(
-            rangeSize);
+                                        is_trivial_formatable || has_fixed_schema
+                                          ? detail::RangeLayout::compact
+                                          : detail::RangeLayout::on_ti_each>(rangeSize);
 
         printer.printHelper(typeIdentifier);
 
         appendSized(rangeSize, size, [&](auto const&... valueArgs) {
             printer.printHelper(valueArgs...);
         });
+    }
+
+    template<typename R,
+             typename Printer>
+    static constexpr void formatImpl(R&          range,
+                                     std::size_t size,
+                                     Printer&    printer) {
+        formatHeader(size, printer);
 
         if constexpr(is_trivial_formatable) {
             if constexpr(is_contiguous) {
@@ -612,11 +1165,74 @@ private:
                     }
                 }
             }
-        } else {
+        } else if constexpr(has_fixed_schema) {
+            if(size != 0) {
+                using schema = detail::Schema<value_t>;
+                auto append  = [&](auto const&... valueArgs) { printer.printHelper(valueArgs...); };
+
+                auto state = schema::initial();
+                for(auto const& element : range) { schema::widen(state, element); }
+                schema::header(state, append);
+                if constexpr(is_contiguous && std::is_trivially_copyable_v<value_t>) {
+                    if(schema::bytewise(state)) {
+                        printer.lowprint(range);
+                        return;
+                    }
+                }
+                for(auto const& element : range) { schema::payload(state, element, append); }
+            }
+        } else {
             for(auto const& element : range) { formatter<value_t>{}.format(element, printer); }
         }
     }
 
+    // A schema with a State has to see every element before the first one goes out.
+    static constexpr bool stageable = []() {
+        if constexpr(has_fixed_schema) {
+            return range_staging_size != 0
+                && std::is_empty_v<typename detail::Schema<value_t>::State>;
+        } else {
+            return range_staging_size != 0;
+        }
+    }();
+
+    // Serializes the elements into a staging buffer, counting them on the way, and sends the
+    // header and the buffer: the same bytes formatImpl sends, with one walk over the range. False,
+    // with nothing sent, if they do not fit. StagingPrinter is a parameter only because Printer is
+    // not defined yet at this point.
+    template<typename Printer,
+             typename StagingPrinter
+             = remote_fmt::Printer<detail::StagingBackend<range_staging_size>>>
+    static constexpr bool formatStaged(T&       range,
+                                       Printer& printer) {
+        StagingPrinter staging{};
+        auto& backend = staging.get_com_backend();
+        auto  append  = [&](auto const&... valueArgs) { staging.printHelper(valueArgs...); };
+
+        std::size_t count = 0;
+        for(auto const& element : range) {
+            if constexpr(is_trivial_formatable) {
+                if(count == 0) {
+                    formatter<value_t>{}.format(element, staging);
+                } else {
+                    staging.printHelper(element);
+                }
+            } else if constexpr(has_fixed_schema) {
+                using schema = detail::Schema<value_t>;
+                if(count == 0) { schema::header(schema::initial(), append); }
+                schema::payload(schema::initial(), element, append);
+            } else {
+                formatter<value_t>{}.format(element, staging);
+            }
+            if(backend.overflowed) { return false; }
+            ++count;
+        }
+
+        formatHeader(count, printer);
+        printer.lowprint(backend.staged());
+        return true;
+    }
+
 public:
     template<typename Printer>
     constexpr auto format(T const& range,
@@ -626,13 +1242,17 @@ public:
         formatImpl(const_cast<T&>(range), std::ranges::size(range), printer);
     }
 
+    // Arguments arrive as const, and a view such as filter_view can only be walked non-const.
     template<typename Printer>
-    constexpr auto format(T&       range,
+    constexpr auto format(T const& constRange,
                           Printer& printer) const
         requires(!std::ranges::sized_range<T>) && std::ranges::forward_range<T>
     {
-        auto       copy = range;
-        auto const size = static_cast<std::size_t>(std::ranges::distance(copy));
+        T& range = const_cast<T&>(constRange);
+        if constexpr(stageable) {
+            if(formatStaged(range, printer)) { return; }
+        }
+        auto const size = static_cast<std::size_t>(std::ranges::distance(range));
         formatImpl(range, size, printer);
     }
 };
@@ -660,6 +1280,159 @@ struct formatter<T> {
     }
 };
 
+namespace detail {
+    // What a scalar field of an aggregate goes out as: what its own formatter would send, minus
+    // the identifier. An enum is its underlying integer here, not its name.
+    template<typename F>
+    consteval auto aggregateWireType() {
+        if constexpr(std::is_pointer_v<F>) {
+            return std::type_identity<std::uintptr_t>{};
+        } else if constexpr(std::is_enum_v<F>) {
+            return std::type_identity<enum_wire_t<F>>{};
+        } else {
+            return std::type_identity<F>{};
+        }
+    }
+
+    template<typename F>
+    using aggregate_wire_t = typename decltype(aggregateWireType<F>())::type;
+
+    template<typename F>
+    concept is_aggregate_field = (std::is_arithmetic_v<F> || std::is_enum_v<F>
+                                  || (std::is_pointer_v<F> && sizeof(F) == sizeof(std::uintptr_t)))
+                              && 8 >= sizeof(F);
+
+    template<typename T>
+    consteval bool fieldsAreAggregateFields() {
+        return []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (is_aggregate_field<field_t<T, Is>> && ...);
+        }(std::make_index_sequence<scalar_field_count<T>>{});
+    }
+
+    // A plain struct of arithmetic, enum and pointer fields. Tuple-likes and ranges keep their
+    // own formatters.
+    template<typename T>
+    concept is_scalar_aggregate = std::is_aggregate_v<T> && !std::is_array_v<T> && !is_tuple_like<T>
+                               && !std::ranges::range<T> && scalar_field_count<T> != 0
+                               && fieldsAreAggregateFields<T>();
+
+    template<typename F>
+    consteval std::pair<TrivialType,
+                        TypeSize>
+    aggregateFieldType() {
+        if constexpr(std::is_pointer_v<F>) {
+            return {TrivialType::pointer, typeToTypeSize<std::uintptr_t>()};
+        } else {
+            return *parseTrivialTypeIdentifier(arithmeticTypeIdentifier<aggregate_wire_t<F>>());
+        }
+    }
+
+    template<typename F>
+    constexpr aggregate_wire_t<F> aggregateFieldWire(F const& field) {
+        if constexpr(std::is_pointer_v<F>) {
+            return std::bit_cast<std::uintptr_t>(field);
+        } else {
+            return static_cast<aggregate_wire_t<F>>(field);
+        }
+    }
+
+    template<is_scalar_aggregate T>
+    struct AggregateSchema {
+        using index_sequence = std::make_index_sequence<scalar_field_count<T>>;
+
+        static constexpr auto joined = []() {
+            constexpr std::size_t size = []<std::size_t... Is>(std::index_sequence<Is...>) {
+                // "name:xN," per field, without the last comma.
+                return (std::size_t{} + ... + (fieldName<T, Is>().size() + 4)) - 1;
+            }(index_sequence{});
+
+            std::array<char, size> text{};
+            std::size_t            position = 0;
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (
+                  [&] {
+                      if(position != 0) { text[position++] = ','; }
+                      for(char const character : fieldName<T, Is>()) {
+                          text[position++] = character;
+                      }
+                      text[position++]         = ':';
+                      auto const [type, typeSize] = aggregateFieldType<field_t<T, Is>>();
+                      for(char const character : aggregateFieldCode(type, typeSize)) {
+                          text[position++] = character;
+                      }
+                  }(),
+                  ...);
+            }(index_sequence{});
+            return text;
+        }();
+
+        static constexpr auto text
+          = sc::create([]() { return std::string_view{joined.data(), joined.size()}; });
+
+        static constexpr std::size_t payload_size = []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (std::size_t{} + ... + sizeof(aggregate_wire_t<field_t<T, Is>>));
+        }(index_sequence{});
+
+        // Without padding the payload is the object itself, and goes out in one copy.
+        static constexpr bool contiguous
+          = std::is_trivially_copyable_v<T> && sizeof(T) == payload_size;
+    };
+
+    // The aggregate identifier and the schema string ahead of the first element, then fields only.
+    template<is_scalar_aggregate T>
+    struct Schema<T> {
+        static constexpr bool fixed = true;
+
+        struct State {};
+
+        static constexpr State initial() { return {}; }
+
+        static constexpr void widen(State&,
+                                    T const&) {}
+
+        static constexpr bool bytewise(State const&) { return AggregateSchema<T>::contiguous; }
+
+        template<typename Append>
+        static constexpr void header(State const&,
+                                     Append append) {
+            appendExtendedTypeIdentifier<ExtendedTypeIdentifier::aggregate>(append);
+            appendStringConstant(AggregateSchema<T>::text, append);
+        }
+
+        template<typename Append>
+        static constexpr void payload(State const&,
+                                      T const& value,
+                                      Append   append) {
+            std::apply([&](auto const&... fields) { append(aggregateFieldWire(fields)...); },
+                       tieFields(value));
+        }
+    };
+}   // namespace detail
+
+// The schema names the fields and their types, so the payload carries no identifiers at all.
+template<detail::is_scalar_aggregate T>
+struct formatter<T> {
+    template<typename Printer>
+    constexpr auto format(T const& value,
+                          Printer& printer) const {
+        using schema = detail::AggregateSchema<T>;
+
+        detail::appendExtendedTypeIdentifier<detail::ExtendedTypeIdentifier::aggregate>(
+          [&](auto const&... valueArgs) { printer.printHelper(valueArgs...); });
+        formatter<std::remove_cvref_t<decltype(schema::text)>>{}.format(schema::text, printer);
+
+        if constexpr(schema::contiguous) {
+            printer.lowprint(std::as_bytes(std::span{std::addressof(value), 1}));
+        } else {
+            std::apply(
+              [&](auto const&... fields) {
+                  (printer.printHelper(detail::aggregateFieldWire(fields)), ...);
+              },
+              detail::tieFields(value));
+        }
+    }
+};
+
 template<typename T>
 struct formatter<std::optional<T>> {
     template<typename Printer>
@@ -774,19 +1547,393 @@ struct formatter<fmt::detail::styled_arg<T>> {
 };
 #endif
 
+namespace detail {
+    // Names a format string at run time, for the frames a RepeatFilter held back, the type-erased
+    // encoder and print_runtime: its catalog id in catalog mode, its text otherwise. The text is
+    // the StringConstant's static storage, so it outlives the call. print_runtime sends either in
+    // both modes.
+    struct FmtStringRef {
+        std::string_view text;
+        std::uint16_t    id;
+        bool             cataloged;
+    };
+
+    template<char... chars>
+    constexpr FmtStringRef fmtStringRef(sc::StringConstant<chars...> fmt) {
+        if constexpr(use_catalog) {
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wundefined-func-template"
+#endif
+            return {{}, catalog<decltype(fmt)>(), true};
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+        } else {
+            return {std::string_view{fmt}, 0, false};
+        }
+    }
+
+    struct RepeatNotice {
+        FmtStringRef  fmtString;
+        std::uint32_t count;
+    };
+
+    static_assert(REMOTE_FMT_UNSIGNED == static_cast<int>(TrivialType::unsigned_)
+                  && REMOTE_FMT_SIGNED == static_cast<int>(TrivialType::signed_)
+                  && REMOTE_FMT_BOOL == static_cast<int>(TrivialType::boolean)
+                  && REMOTE_FMT_CHAR == static_cast<int>(TrivialType::character)
+                  && REMOTE_FMT_POINTER == static_cast<int>(TrivialType::pointer)
+                  && REMOTE_FMT_FLOAT == static_cast<int>(TrivialType::floatingpoint),
+                  "c_printer.h type values out of step with the wire format");
+
+    // The combinations the formatters of the corresponding C++ types send, nothing else.
+    constexpr bool isValidRuntimeArg(remote_fmt_arg const& arg) {
+        if(arg.type == REMOTE_FMT_STRING) { return true; }
+        if(arg.value == nullptr) { return false; }
+        switch(arg.type) {
+        case REMOTE_FMT_UNSIGNED:
+        case REMOTE_FMT_SIGNED:
+            return arg.size == 1 || arg.size == 2 || arg.size == 4 || arg.size == 8;
+        case REMOTE_FMT_BOOL:
+        case REMOTE_FMT_CHAR:    return arg.size == 1;
+        case REMOTE_FMT_POINTER: return arg.size == sizeof(std::uintptr_t);
+        case REMOTE_FMT_FLOAT:   return arg.size == sizeof(float) || arg.size == sizeof(double);
+        default:                 return false;
+        }
+    }
+
+    // A run of bool arguments for the type-erased encoder, bit i set for the i-th one.
+    struct FlagGroup {
+        std::uint16_t flags;
+        std::size_t   count;
+    };
+
+    // FNV-1a over everything a frame would put on the wire, so two prints hash alike exactly when
+    // they would send the same bytes.
+    struct HashBackend {
+        std::uint32_t hash{2166136261U};
+
+        constexpr void write(std::span<std::byte const> data) {
+            for(std::byte const b : data) {
+                hash = (hash ^ std::to_integer<std::uint32_t>(b)) * 16777619U;
+            }
+        }
+    };
+
+    struct CountBackend {
+        std::size_t size{};
+
+        constexpr void write(std::span<std::byte const> data) { size += data.size(); }
+    };
+
+    // Upper bound of the bytes an argument of type T takes, for the types where it is known at
+    // compile time; 0 for the rest, whose size a frame only learns by serializing them.
+    template<typename T>
+    constexpr std::size_t wire_size_bound = 0;
+
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    constexpr std::size_t wire_size_bound<T> = 1 + sizeof(T);
+
+    template<typename T>
+        requires std::is_same_v<T, void*> || std::is_same_v<T, void const*>
+              || std::is_same_v<T, std::nullptr_t>
+    constexpr std::size_t wire_size_bound<T> = 1 + sizeof(std::uintptr_t);
+
+    template<is_scalar_aggregate T>
+    constexpr std::size_t wire_size_bound<T> = [] {
+        using schema = AggregateSchema<T>;
+        constexpr std::size_t schemaSize
+          = use_catalog ? 1 + sizeof(std::uint16_t)
+                        : 1 + byteSize(rangeSizeToTypeSize(sizeToRangeSize(schema::joined.size())))
+                            + schema::joined.size();
+        return 2 + schemaSize + schema::payload_size;
+    }();
+}   // namespace detail
+
+// The header a frame with this format string starts with, level prefix included.
+template<>
+struct formatter<detail::FmtStringRef> {
+    template<typename Printer>
+    constexpr auto format(detail::FmtStringRef const& fmtString,
+                          Printer&                    printer) const {
+        auto append = [&](auto const&... valueArgs) { printer.printHelper(valueArgs...); };
+        if(fmtString.cataloged) {
+            auto constexpr rangeSize
+              = detail::sizeToRangeSize(std::numeric_limits<std::uint16_t>::max());
+            printer.printHelper(
+              detail::fmtStringTypeIdentifier<detail::FmtStringType::cataloged_normal>(rangeSize));
+            appendSized(rangeSize, fmtString.id, append);
+        } else {
+            auto const rangeSize = detail::sizeToRangeSize(fmtString.text.size());
+            printer.printHelper(
+              detail::fmtStringTypeIdentifier<detail::FmtStringType::normal>(rangeSize));
+            appendSized(rangeSize, fmtString.text.size(), append);
+            printer.lowprint(fmtString.text);
+        }
+    }
+};
+
+template<>
+struct formatter<detail::FlagGroup> {
+    template<typename Printer>
+    constexpr auto format(detail::FlagGroup const& group,
+                          Printer&                 printer) const {
+        detail::appendFlags(group.flags, group.count, [&](auto const&... values) {
+            printer.printHelper(values...);
+        });
+    }
+};
+
+// The count, then the format string header exactly as the held-back frames started, so the host
+// files the notice under the same level.
+template<>
+struct formatter<detail::RepeatNotice> {
+    template<typename Printer>
+    constexpr auto format(detail::RepeatNotice const& notice,
+                          Printer&                    printer) const {
+        detail::appendExtendedTypeIdentifier<detail::ExtendedTypeIdentifier::repeated>(
+          [&](auto const&... valueArgs) { printer.printHelper(valueArgs...); });
+        printer.printHelper(notice.count);
+        formatter<detail::FmtStringRef>{}.format(notice.fmtString, printer);
+    }
+};
+
+// Printer policy against fault storms. A frame identical to one sent less than window ago is
+// held back and counted. When the window has run out - checked on the next print, or by
+// Printer::flush_repeats - the count goes out as one notice, which the host renders as
+// "<format string>" repeated N times. Slots frames are tracked at once; a new one evicts the
+// oldest, sending its count first. Clock needs a static now(), like the std::chrono clocks.
+template<typename Clock,
+         std::size_t Slots = 8>
+class RepeatFilter {
+public:
+    using duration   = typename Clock::duration;
+    using time_point = typename Clock::time_point;
+
+    constexpr explicit RepeatFilter(duration window_) : window{window_} {}
+
+    // False for a repeat, which is counted. notify(FmtStringRef, count) is called for the entries
+    // that expire or get evicted with frames held back, before the admitted frame goes out. An
+    // admitted frame is only tracked once record says it went out.
+    template<typename Notify>
+    bool admit(std::uint32_t hash,
+               Notify&&      notify) {
+        auto const now    = Clock::now();
+        Entry*     oldest = nullptr;
+        for(Entry& entry : entries) {
+            if(entry.used && now - entry.start >= window) { release(entry, notify); }
+            if(entry.used && entry.hash == hash) {
+                if(entry.heldBack != std::numeric_limits<std::uint32_t>::max()) { ++entry.heldBack; }
+                return false;
+            }
+            if(oldest == nullptr || (oldest->used && (!entry.used || entry.start < oldest->start))) {
+                oldest = &entry;
+            }
+        }
+
+        // Leaves a free slot for record.
+        release(*oldest, notify);
+        return true;
+    }
+
+    // Tracks a frame admit let through, once the transport took it. A dropped frame is not
+    // recorded, so its repeats are not held back behind a message the host never saw.
+    void record(std::uint32_t        hash,
+                detail::FmtStringRef fmtString) {
+        for(Entry& entry : entries) {
+            if(!entry.used) {
+                entry = Entry{true, hash, fmtString, Clock::now(), 0};
+                return;
+            }
+        }
+    }
+
+    template<typename Notify>
+    void flush(Notify&& notify) {
+        for(Entry& entry : entries) { release(entry, notify); }
+    }
+
+private:
+    struct Entry {
+        bool                 used;
+        std::uint32_t        hash;
+        detail::FmtStringRef fmtString;
+        time_point           start;
+        std::uint32_t        heldBack;
+    };
+
+    template<typename Notify>
+    static void release(Entry&  entry,
+                        Notify& notify) {
+        if(entry.used && entry.heldBack != 0) { notify(entry.fmtString, entry.heldBack); }
+        entry.used = false;
+    }
+
+    duration                 window;
+    std::array<Entry, Slots> entries{};
+};
+
+namespace detail {
+    // Per argument: 1 to format it on its own, n > 1 for the first bool of a flags group of n,
+    // 0 for a bool that already went out in an earlier group.
+    template<typename... Args>
+    consteval std::array<std::size_t, sizeof...(Args)> flagGroups() {
+        constexpr std::array<bool, sizeof...(Args)> isBool{
+          std::is_same_v<std::remove_cvref_t<Args>, bool>...};
+
+        std::array<std::size_t, sizeof...(Args)> groups{};
+        for(std::size_t index = 0; index < isBool.size();) {
+            std::size_t run = 0;
+            while(index + run < isBool.size() && isBool[index + run] && run < Max_flags_per_group) {
+                ++run;
+            }
+            groups[index] = run < 2 ? 1 : run;
+            index += run < 2 ? 1 : run;
+        }
+        return groups;
+    }
+
+    // Forwards to the write of another Printer, so that the type-erased encoder is compiled once,
+    // as Printer<SinkBackend>, whatever the backend.
+    struct SinkBackend {
+        void* target;
+        void (*forward)(void*, std::span<std::byte const>);
+
+        void write(std::span<std::byte const> data) const { forward(target, data); }
+    };
+
+    using ErasedPrinter = Printer<SinkBackend>;
+
+    // Sends the arguments starting at values[0]: one, or a whole flags group for the first bool of
+    // one. Every argument type gets a single instance, shared by all call sites.
+    using ErasedEncoder = void (*)(ErasedPrinter&, void const* const*);
+
+    template<typename T>
+    void encodeErasedArg(ErasedPrinter&     printer,
+                         void const* const* values);
+
+    template<std::size_t GroupSize>
+    void encodeErasedFlags(ErasedPrinter&     printer,
+                           void const* const* values);
+
+    // Per argument its encoder, nullptr for a bool that goes out with the group before it.
+    template<typename... Args>
+    consteval std::array<ErasedEncoder, sizeof...(Args)> erasedEncoders() {
+        constexpr auto groups = flagGroups<Args...>();
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::array<ErasedEncoder, sizeof...(Args)>{[&]() -> ErasedEncoder {
+                if constexpr(groups[Is] == 1) {
+                    return &encodeErasedArg<std::tuple_element_t<Is, std::tuple<Args...>>>;
+                } else if constexpr(groups[Is] > 1) {
+                    return &encodeErasedFlags<groups[Is]>;
+                } else {
+                    return nullptr;
+                }
+            }()...};
+        }(std::index_sequence_for<Args...>{});
+    }
+
+    // One table per argument type list in flash, shared by all format strings using it.
+    template<typename... Args>
+    inline constexpr std::array<ErasedEncoder, sizeof...(Args)> erased_encoders
+      = erasedEncoders<Args...>();
+
+    constexpr std::size_t fmtStringHeaderSize(std::size_t textSize) {
+        if constexpr(use_catalog) {
+            return 1 + sizeof(std::uint16_t);
+        } else {
+            return 1 + byteSize(rangeSizeToTypeSize(sizeToRangeSize(textSize))) + textSize;
+        }
+    }
+
+    // Start and end marker included; 0 where an argument's size depends on its value.
+    template<typename Fmt,
+             typename... Args>
+    consteval std::size_t frameSizeBound() {
+        if constexpr((... && (wire_size_bound<Args> != 0))) {
+            return 2 + fmtStringHeaderSize(std::string_view{Fmt{}}.size())
+                 + (std::size_t{} + ... + wire_size_bound<Args>);
+        } else {
+            return 0;
+        }
+    }
+
+    // Everything a type-erased print knows at compile time, in flash, so that the call site only
+    // passes a pointer to it and one to its arguments. Kept small, there is one per call site: the
+    // format string is its text in normal mode, the function returning its id in catalog mode.
+    struct ErasedCallSite {
+        std::conditional_t<use_catalog, std::uint16_t (*)(), char const*> fmtStringSource;
+        std::uint32_t                                                     textSize;
+        std::uint16_t                                                     sizeBound;
+        std::uint16_t                                                     argCount;
+        ErasedEncoder const*                                              encoders;
+
+        FmtStringRef fmtString() const { return fmtStringFrom(fmtStringSource, textSize); }
+
+        std::span<ErasedEncoder const> args() const { return {encoders, argCount}; }
+
+    private:
+        static FmtStringRef fmtStringFrom(std::uint16_t (*catalogId)(),
+                                          std::uint32_t) {
+            return {{}, catalogId(), true};
+        }
+
+        static FmtStringRef fmtStringFrom(char const*   text,
+                                          std::uint32_t size) {
+            return {{text, size}, 0, false};
+        }
+    };
+
+    template<typename Fmt,
+             typename... Args>
+    consteval ErasedCallSite erasedCallSite() {
+        constexpr std::size_t bound = frameSizeBound<Fmt, Args...>();
+        constexpr auto sizeBound    = static_cast<std::uint16_t>(
+          bound <= std::numeric_limits<std::uint16_t>::max() ? bound : 0);
+        if constexpr(use_catalog) {
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wundefined-func-template"
+#endif
+            return {&catalog<Fmt>, 0, sizeBound, sizeof...(Args), erased_encoders<Args...>.data()};
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+        } else {
+            constexpr std::string_view text{Fmt{}};
+            return {text.data(),
+                    static_cast<std::uint32_t>(text.size()),
+                    sizeBound,
+                    sizeof...(Args),
+                    erased_encoders<Args...>.data()};
+        }
+    }
+
+    template<typename Fmt,
+             typename... Args>
+    inline constexpr ErasedCallSite erased_call_site = erasedCallSite<Fmt, Args...>();
+}   // namespace detail
+
 template<typename Printer,
          char... chars,
          typename... Args>
 static constexpr auto format_to(Printer&                     printer,
                                 sc::StringConstant<chars...> fmt,
                                 Args&&... args) {
-    checkFormatString<decltype(args)...>(fmt);
+    static_assert(detail::format_string_checked<decltype(fmt), std::remove_cvref_t<Args>...>);
     return printer.format(fmt, std::forward<Args>(args)...);
 }
 
-template<typename ComBackend>
+template<typename ComBackend,
+         typename RepeatPolicy>
 struct Printer {
 private:
+    template<typename,
+             typename>
+    friend struct Printer;
+
     template<std::size_t Extent = std::dynamic_extent>
     void constexpr lowprint(std::span<std::byte const,
                                       Extent> span) {
@@ -835,14 +1982,14 @@ private:
 
     constexpr Printer& out() { return *this; }
 
+    // Unchecked: format_to and print have checked the format string, print before a level
+    // prefix went on, which the check would refuse.
     template<detail::FmtStringType ft
              = detail::maybeCataloged<detail::FmtStringType::cataloged_sub>(),
              char... chars,
              typename... Args>
     constexpr void format(sc::StringConstant<chars...> fmt,
                           Args&&... args) {
-        checkFormatString<decltype(args)...>(fmt);
-
         if constexpr(ft == detail::FmtStringType::sub || ft == detail::FmtStringType::normal) {
             auto constexpr stringView = std::string_view{fmt};
             auto constexpr rangeSize  = detail::sizeToRangeSize(stringView.size());
@@ -871,28 +2018,105 @@ private:
 #endif
         }
 
-        (formatter<std::remove_cvref_t<Args>>{}.format(std::forward<Args>(args), *this), ...);
+        formatArgs(std::forward<Args>(args)...);
+    }
+
+    template<std::size_t Index,
+             std::size_t GroupSize,
+             typename ArgRefs>
+    constexpr void formatArg(ArgRefs& argRefs) {
+        if constexpr(GroupSize == 1) {
+            using Arg = std::tuple_element_t<Index, ArgRefs>;
+            formatter<std::remove_cvref_t<Arg>>{}.format(std::forward<Arg>(std::get<Index>(argRefs)),
+                                                         *this);
+        } else if constexpr(GroupSize > 1) {
+            auto const flags = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return static_cast<std::uint16_t>(
+                  ((static_cast<unsigned>(static_cast<bool>(std::get<Index + Is>(argRefs))) << Is)
+                   | ...));
+            }(std::make_index_sequence<GroupSize>{});
+            detail::appendFlags(flags, GroupSize, [&](auto const&... values) {
+                printHelper(values...);
+            });
+        }
     }
 
-    [[no_unique_address]] ComBackend comBackend{};
+    template<typename... Args>
+    constexpr void formatArgs(Args&&... args) {
+        auto argRefs = std::forward_as_tuple(std::forward<Args>(args)...);
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (formatArg<Is, detail::flagGroups<Args...>()[Is]>(argRefs), ...);
+        }(std::index_sequence_for<Args...>{});
+    }
 
-public:
-    constexpr Printer() = default;
+    static constexpr bool has_reserve = requires(ComBackend& backend, std::size_t size) {
+        { backend.reserve(size) } -> std::convertible_to<bool>;
+    };
 
-    template<typename Cb>
-        requires std::is_same_v<std::remove_cvref_t<Cb>,
-                                std::remove_cvref_t<ComBackend>>
-    constexpr explicit Printer(Cb&& callback) : comBackend{std::forward<Cb>(callback)} {}
+    constexpr bool reserve(std::size_t size) {
+        if constexpr(requires { ComBackend::reserve(size); }) {
+            return ComBackend::reserve(size);
+        } else {
+            return comBackend.reserve(size);
+        }
+    }
 
-    ComBackend const& get_com_backend() const { return comBackend; }
+    // Serializes the frame body into printer, whatever its backend: the real one, a count or a
+    // hash.
+    template<char... chars,
+             typename... Args>
+    static constexpr auto frameEncoder(sc::StringConstant<chars...> fmt,
+                                       Args const&... args) {
+        return [fmt, &args...](auto& printer) {
+            printer.template format<detail::maybeCataloged<detail::FmtStringType::cataloged_normal>()>(
+              fmt,
+              args...);
+        };
+    }
 
-    ComBackend& get_com_backend() { return comBackend; }
+    template<typename Encode>
+    static constexpr std::size_t countedFrameSize(Encode const& encode) {
+        Printer<detail::CountBackend> counter{};
+        encode(counter);
+        return 2 + counter.comBackend.size;
+    }
 
+    // Start and end marker included. Exact when an argument's size depends on its value, since
+    // then the frame is serialized once to count it; an upper bound from the types otherwise.
     template<char... chars,
+             typename Encode,
              typename... Args>
-    constexpr void print(sc::StringConstant<chars...> fmt,
-                         Args&&... args) {
-        checkFormatString<decltype(args)...>(fmt);
+    static constexpr std::size_t frameSize(sc::StringConstant<chars...>,
+                                           Encode const& encode,
+                                           Args const&...) {
+        constexpr std::size_t bound
+          = detail::frameSizeBound<sc::StringConstant<chars...>, std::remove_cvref_t<Args>...>();
+        if constexpr(bound != 0) {
+            return bound;
+        } else {
+            return countedFrameSize(encode);
+        }
+    }
+
+    // A backend with reserve(size) is asked for room for the whole frame first, and the frame is
+    // dropped as a unit if there is none - never cut off halfway, which would cost the host the
+    // next frame as well while it resyncs. The drops are counted and reported at the front of the
+    // next frame that fits. frameSize is only asked when there is a reserve. False for a dropped
+    // frame.
+    template<typename FrameSize,
+             typename Encode>
+    constexpr bool transmit(FrameSize const& frameSize,
+                            Encode const&    encode) {
+        std::uint32_t dropped{};
+        if constexpr(has_reserve) {
+            dropped = droppedFrames.take();
+            std::size_t const reportSize
+              = dropped == 0 ? 0 : 1 + detail::byteSize(detail::sizeToTypeSize(dropped));
+            if(!reserve(frameSize() + reportSize)) {
+                droppedFrames.add(dropped + 1);
+                return false;
+            }
+        }
 
         if constexpr(requires { ComBackend::initTransfer(); }) {
             ComBackend::initTransfer();
@@ -901,9 +2125,10 @@ public:
         }
 
         printHelper(protocol::Start_marker);
-        format<detail::maybeCataloged<detail::FmtStringType::cataloged_normal>()>(
-          fmt,
-          std::forward<Args>(args)...);
+        if(dropped != 0) {
+            detail::appendDropReport(dropped, [&](auto const&... values) { printHelper(values...); });
+        }
+        encode(*this);
         printHelper(protocol::End_marker);
 
         if constexpr(requires { ComBackend::finalizeTransfer(); }) {
@@ -911,19 +2136,348 @@ public:
         } else if constexpr(requires { comBackend.finalizeTransfer(); }) {
             comBackend.finalizeTransfer();
         }
+        return true;
+    }
+
+    // Everything between print and the wire: the call site bitmap, the repeat filter, which hashes
+    // the frame by serializing it a second time, and transmit.
+    template<typename FmtStringRef,
+             typename FrameSize,
+             typename Encode>
+    constexpr void emitFrame(FmtStringRef const& fmtStringRef,
+                             FrameSize const&    frameSize,
+                             Encode const&       encode) {
+        if constexpr(use_catalog && call_site_slots != 0) {
+            detail::FmtStringRef const site = fmtStringRef();
+            if(site.cataloged && !call_site_enabled(site.id)) { return; }
+        }
+
+        if constexpr(std::is_same_v<RepeatPolicy, NoRepeatFilter>) {
+            transmit(frameSize, encode);
+        } else {
+            Printer<detail::HashBackend> hasher{};
+            encode(hasher);
+            std::uint32_t const hash = hasher.comBackend.hash;
+            bool const          admitted
+              = repeatFilter.admit(hash, [this](detail::FmtStringRef fmtString, std::uint32_t count) {
+                    sendRepeatNotice(fmtString, count);
+                });
+            if(admitted && transmit(frameSize, encode)) {
+                repeatFilter.record(hash, fmtStringRef());
+            }
+        }
+    }
+
+    void sendRepeatNotice(detail::FmtStringRef fmtString,
+                          std::uint32_t        count) {
+        detail::RepeatNotice const notice{fmtString, count};
+        auto const encode = frameEncoder(sc::StringConstant<'{', '}'>{}, notice);
+        transmit([&] { return countedFrameSize(encode); }, encode);
+    }
+
+    // A backend for the type-erased encoder that writes to target.
+    template<typename Target>
+    static detail::SinkBackend sinkFor(Target& target) {
+        return {std::addressof(target), [](void* self, std::span<std::byte const> data) {
+                    static_cast<Target*>(self)->lowprint(data);
+                }};
+    }
+
+    // The type_erased print, one instance per Printer type instead of one per call site.
+    [[gnu::noinline]] void printErased(detail::ErasedCallSite const& callSite,
+                                       void const* const*            values) {
+        detail::FmtStringRef const fmtString = callSite.fmtString();
+
+        auto const encode = [&](auto& printer) {
+            detail::ErasedPrinter erased{sinkFor(printer)};
+            erased.encodeErased(fmtString, callSite.args(), values);
+        };
+        auto const frameSize = [&] {
+            return callSite.sizeBound != 0 ? std::size_t{callSite.sizeBound}
+                                           : countedFrameSize(encode);
+        };
+        emitFrame([&] { return fmtString; }, frameSize, encode);
+    }
+
+    bool printRuntime(detail::FmtStringRef            fmtString,
+                      std::span<remote_fmt_arg const> args) {
+        if(!std::ranges::all_of(args, detail::isValidRuntimeArg)) { return false; }
+
+        auto const encode = [&](auto& printer) {
+            formatter<detail::FmtStringRef>{}.format(fmtString, printer);
+            for(std::size_t index = 0; index < args.size();) {
+                // Runs of bools go out as flags groups, as flagGroups splits them for print.
+                std::size_t run = 0;
+                while(index + run < args.size() && args[index + run].type == REMOTE_FMT_BOOL
+                      && run < detail::Max_flags_per_group)
+                {
+                    ++run;
+                }
+                if(run >= 2) {
+                    std::uint16_t flags{};
+                    for(std::size_t bit = 0; bit < run; ++bit) {
+                        if(*static_cast<std::uint8_t const*>(args[index + bit].value) != 0) {
+                            flags = static_cast<std::uint16_t>(flags | (1U << bit));
+                        }
+                    }
+                    formatter<detail::FlagGroup>{}.format(detail::FlagGroup{flags, run}, printer);
+                    index += run;
+                    continue;
+                }
+
+                remote_fmt_arg const& arg = args[index];
+                ++index;
+                if(arg.type == REMOTE_FMT_STRING) {
+                    auto const* const string = static_cast<char const*>(arg.value);
+                    formatter<std::string_view>{}.format(
+                      string == nullptr ? std::string_view{} : std::string_view{string},
+                      printer);
+                } else {
+                    printer.printHelper(detail::trivialTypeIdentifier(
+                      static_cast<detail::TrivialType>(arg.type),
+                      static_cast<detail::TypeSize>(std::countr_zero(arg.size))));
+                    printer.lowprint(std::span{static_cast<std::byte const*>(arg.value), arg.size});
+                }
+            }
+        };
+        emitFrame([&] { return fmtString; }, [&] { return countedFrameSize(encode); }, encode);
+        return true;
+    }
+
+    // The loop behind printErased, only ever compiled as ErasedPrinter::encodeErased.
+    void encodeErased(detail::FmtStringRef                   fmtString,
+                      std::span<detail::ErasedEncoder const> encoders,
+                      void const* const*                     values) {
+        formatter<detail::FmtStringRef>{}.format(fmtString, *this);
+        for(std::size_t index = 0; index < encoders.size(); ++index) {
+            if(encoders[index] != nullptr) { encoders[index](*this, values + index); }
+        }
+    }
+
+    [[no_unique_address]] ComBackend   comBackend{};
+    [[no_unique_address]] RepeatPolicy repeatFilter{};
+    // Per instance, so that two links with the same backend type each report their own drops.
+    [[no_unique_address]] std::conditional_t<has_reserve,
+                                             detail::DropCounter,
+                                             detail::NoDropCounter> droppedFrames{};
+
+    // The one Printer all staticPrint calls share, so that drops carry over from one to the next.
+    static Printer& staticPrinter() {
+        static Printer printer{};
+        return printer;
+    }
+
+public:
+    constexpr Printer() = default;
+
+    template<typename Cb>
+        requires std::is_same_v<std::remove_cvref_t<Cb>,
+                                std::remove_cvref_t<ComBackend>>
+    constexpr explicit Printer(Cb&& callback) : comBackend{std::forward<Cb>(callback)} {}
+
+    constexpr explicit Printer(RepeatPolicy repeatPolicy)
+        requires(!std::is_same_v<RepeatPolicy, NoRepeatFilter>)
+      : repeatFilter{std::move(repeatPolicy)} {}
+
+    template<typename Cb>
+        requires std::is_same_v<std::remove_cvref_t<Cb>,
+                                std::remove_cvref_t<ComBackend>>
+    constexpr Printer(Cb&&         callback,
+                      RepeatPolicy repeatPolicy)
+      : comBackend{std::forward<Cb>(callback)}
+      , repeatFilter{std::move(repeatPolicy)} {}
+
+    ComBackend const& get_com_backend() const { return comBackend; }
+
+    ComBackend& get_com_backend() { return comBackend; }
+
+    template<char... chars,
+             typename... Args>
+    constexpr void print(sc::StringConstant<chars...> fmt,
+                         Args&&... args) {
+        static_assert(detail::format_string_checked<decltype(fmt), std::remove_cvref_t<Args>...>);
+        printChecked(fmt, args...);
+    }
+
+private:
+    // print after the format string check, which a leveled print has done on the format string
+    // without its prefix.
+    template<char... chars,
+             typename... Args>
+    constexpr void printChecked(sc::StringConstant<chars...> fmt,
+                                Args const&... args) {
+        if constexpr(type_erased) {
+            std::array<void const*, sizeof...(Args)> const values{
+              static_cast<void const*>(std::addressof(args))...};
+            printErased(detail::erased_call_site<decltype(fmt), std::remove_cvref_t<Args>...>,
+                        values.data());
+        } else {
+            auto const encode = frameEncoder(fmt, args...);
+            emitFrame([fmt] { return detail::fmtStringRef(fmt); },
+                      [&] { return frameSize(fmt, encode, args...); },
+                      encode);
+        }
+    }
+
+public:
+    // For code that cannot use StringConstant, C in particular - see c_printer.h. The format
+    // string and the argument types arrive at run time; the frame is the one print sends for the
+    // same format string and values. False, and nothing sent, for an invalid descriptor, a format
+    // string that print would not compile with for want of valid characters, fields or argument
+    // count, or a spec the host would refuse. A spec wrong for its argument's type goes out, and
+    // the host reports it, since the device has no fmt to check it with.
+    bool print_runtime(char const*                     fmt,
+                       std::span<remote_fmt_arg const> args) {
+        std::string_view const text = fmt == nullptr ? std::string_view{} : std::string_view{fmt};
+        if(text.size() > std::numeric_limits<std::uint16_t>::max() || !detail::allCharsValid(text)
+           || detail::checkReplacementFieldCount(text) != args.size()
+           || !detail::fieldsCarryNoArgumentId(text) || !detail::fieldsWithinLimits(text))
+        {
+            return false;
+        }
+        return printRuntime({text, 0, false}, args);
+    }
+
+    // The format string by its catalog id. Works in either mode, as long as the host has the id.
+    bool print_runtime(std::uint16_t                   catalogId,
+                       std::span<remote_fmt_arg const> args) {
+        return printRuntime({{}, catalogId, true}, args);
+    }
+
+    // Sends the counts of everything the repeat filter is holding back, e.g. when the link goes
+    // idle or before a reset.
+    void flush_repeats()
+        requires(!std::is_same_v<RepeatPolicy, NoRepeatFilter>)
+    {
+        repeatFilter.flush([this](detail::FmtStringRef fmtString, std::uint32_t count) {
+            sendRepeatNotice(fmtString, count);
+        });
     }
 
     template<char... chars,
              typename... Args>
     static constexpr void staticPrint(sc::StringConstant<chars...> fmt,
                                       Args&&... args) {
-        checkFormatString<decltype(args)...>(fmt);
+        static_assert(detail::format_string_checked<decltype(fmt), std::remove_cvref_t<Args>...>);
+        static_assert(
+          requires { ComBackend::write(std::span<std::byte const>{}); },
+          "staticPrint needs static ComBackend");
+        static_assert(std::is_same_v<RepeatPolicy, NoRepeatFilter>,
+                      "staticPrint has no Printer to keep the repeat filter in");
+
+        staticPrinter().print(fmt, std::forward<Args>(args)...);
+    }
+
+    // Below the compile-time threshold of its Tag a leveled print is an empty function; below
+    // the runtime threshold it returns before the first byte is serialized. The host gets the
+    // level back from parseWithLevel.
+    template<Level level,
+             typename Tag = void,
+             char... chars,
+             typename... Args>
+    constexpr void print(sc::StringConstant<chars...> fmt,
+                         Args&&... args) {
+        static_assert(detail::format_string_checked<decltype(fmt), std::remove_cvref_t<Args>...>);
+
+        if constexpr(level >= tag_min_level<Tag>) {
+            if(level < runtimeLevel.load(std::memory_order_relaxed)) { return; }
+            printChecked(detail::withLevelPrefix<level>(fmt), args...);
+        }
+    }
+
+    template<Level level,
+             typename Tag = void,
+             char... chars,
+             typename... Args>
+    static constexpr void staticPrint(sc::StringConstant<chars...> fmt,
+                                      Args&&... args) {
+        static_assert(detail::format_string_checked<decltype(fmt), std::remove_cvref_t<Args>...>);
         static_assert(
           requires { ComBackend::write(std::span<std::byte const>{}); },
           "staticPrint needs static ComBackend");
+        static_assert(std::is_same_v<RepeatPolicy, NoRepeatFilter>,
+                      "staticPrint has no Printer to keep the repeat filter in");
+
+        staticPrinter().template print<level, Tag>(fmt, std::forward<Args>(args)...);
+    }
+
+    // Shared by every Printer<ComBackend>, so staticPrint sees it too.
+    static void set_runtime_level(Level level) {
+        runtimeLevel.store(level, std::memory_order_relaxed);
+    }
+
+    static Level get_runtime_level() { return runtimeLevel.load(std::memory_order_relaxed); }
+
+    // Frames dropped since the last one that went out, i.e. the count the next frame will report.
+    std::uint32_t get_dropped_frames() const {
+        if constexpr(has_reserve) {
+            return droppedFrames.load();
+        } else {
+            return 0;
+        }
+    }
 
-        Printer{}.print(fmt, std::forward<Args>(args)...);
+    // Ids at or above call_site_slots have no bit and stay enabled.
+    static bool call_site_enabled(std::uint16_t id) {
+        if(id >= call_site_slots) { return true; }
+        return (callSitesDisabled[id / 32U].load(std::memory_order_relaxed) & (1U << (id % 32U)))
+            == 0;
     }
+
+    static void set_call_sites(CallSiteRange const& range) {
+        if(range.first >= call_site_slots) { return; }
+        std::size_t const last = std::min<std::size_t>(range.last, call_site_slots - 1);
+
+        for(std::size_t word = range.first / 32U; word <= last / 32U; ++word) {
+            std::size_t const  begin = std::max<std::size_t>(range.first, word * 32U) % 32U;
+            std::size_t const  end   = std::min<std::size_t>(last, (word * 32U) + 31U) % 32U;
+            std::uint32_t const mask
+              = (std::numeric_limits<std::uint32_t>::max() >> (31U - end + begin)) << begin;
+
+            if(range.command == CallSiteCommand::enable) {
+                callSitesDisabled[word].fetch_and(~mask, std::memory_order_relaxed);
+            } else {
+                callSitesDisabled[word].fetch_or(mask, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Feed it a packet from encodeCallSiteCommand; anything else is rejected and changes nothing.
+    // Safe to call from a receive interrupt while another context prints.
+    static bool apply_call_site_command(std::span<std::byte const> packet) {
+        auto const range = decodeCallSiteCommand(packet);
+        if(!range) { return false; }
+        set_call_sites(*range);
+        return true;
+    }
+
+private:
+    static inline std::atomic<Level> runtimeLevel{Level::trace};
+
+    // Inverted so that zero initialization leaves every site enabled.
+    static inline std::array<std::atomic<std::uint32_t>,
+                             (call_site_slots + 31U) / 32U>
+      callSitesDisabled{};
 };
 
+namespace detail {
+    template<typename T>
+    void encodeErasedArg(ErasedPrinter&     printer,
+                         void const* const* values) {
+        formatter<T>{}.format(*static_cast<T const*>(values[0]), printer);
+    }
+
+    template<std::size_t GroupSize>
+    void encodeErasedFlags(ErasedPrinter&     printer,
+                           void const* const* values) {
+        std::uint16_t flags{};
+        for(std::size_t bit = 0; bit < GroupSize; ++bit) {
+            if(*static_cast<bool const*>(values[bit])) {
+                flags = static_cast<std::uint16_t>(flags | (1U << bit));
+            }
+        }
+        formatter<FlagGroup>{}.format(FlagGroup{flags, GroupSize}, printer);
+    }
+}   // namespace detail
+
 }   // namespace remote_fmt
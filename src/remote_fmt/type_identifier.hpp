@@ -1,10 +1,14 @@
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <optional>
+#include <ratio>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -41,14 +45,71 @@ namespace remote_fmt { namespace detail {
     // std::visit handed the active alternative straight to its own formatter and nothing marked it -
     // which meant the parser could not tell a variant from a bare value and could not reproduce
     // fmt's variant(...) wrapper. Marking it costs two bytes per variant and is the only way to
-    // match fmt here.
+    // match fmt here. repeated is not an argument type but the notice a RepeatFilter sends for
+    // frames it held back. aggregate is a struct of scalars, see aggregateFieldCode. enumeration
+    // is an enum value as an index into its table of names, which only ranges of enums send.
     enum class ExtendedTypeIdentifier : std::uint8_t {
         styled,
         optional,
         expected,
         void_type,
-        variant
+        variant,
+        repeated,
+        aggregate,
+        enumeration
     };
+    // Kinds of the compact identifiers, see the bit layout above isCompactTypeIdentifier below.
+    enum class CompactType : std::uint8_t {
+        std_ratio_duration,
+        std_ratio_time_point,
+        flags,
+        drop_report
+    };
+
+    // The ratios a duration can name by index instead of spelling out numerator and denominator.
+    // The index is the wire value, so entries are only ever appended. Several are the same ratio
+    // under two names (std::milli and milliseconds::period); the first one wins on the device, and
+    // the parser accepts any of them.
+    using std_ratios = std::tuple<std::atto,
+                                  std::femto,
+                                  std::pico,
+                                  std::nano,
+                                  std::micro,
+                                  std::milli,
+                                  std::centi,
+                                  std::ratio<1>,
+                                  std::deci,
+                                  std::deca,
+                                  std::hecto,
+                                  std::kilo,
+                                  std::mega,
+                                  std::giga,
+                                  std::tera,
+                                  std::peta,
+                                  std::exa,
+                                  std::chrono::nanoseconds::period,
+                                  std::chrono::microseconds::period,
+                                  std::chrono::milliseconds::period,
+                                  std::chrono::seconds::period,
+                                  std::chrono::minutes::period,
+                                  std::chrono::hours::period,
+                                  std::chrono::days::period,
+                                  std::chrono::weeks::period,
+                                  std::chrono::months::period,
+                                  std::chrono::years::period>;
+
+    template<std::intmax_t Num,
+             std::intmax_t Denom>
+    consteval std::optional<std::uint8_t> stdRatioIndex() {
+        return []<std::size_t... Is>(std::index_sequence<Is...>) {
+            std::optional<std::uint8_t> index;
+            (void)((std::tuple_element_t<Is, std_ratios>::num == Num
+                      && std::tuple_element_t<Is, std_ratios>::den == Denom
+                      && (index = static_cast<std::uint8_t>(Is), true))
+                   || ...);
+            return index;
+        }(std::make_index_sequence<std::tuple_size_v<std_ratios>>{});
+    }
 
     template<typename T,
              typename Append>
@@ -281,6 +342,13 @@ namespace remote_fmt { namespace detail {
                         static_cast<TypeSize>(typeSize)>;
     }
 
+    // For types only known at run time.
+    constexpr std::byte trivialTypeIdentifier(TrivialType trivialType,
+                                              TypeSize    typeSize) {
+        return castAndShift(TypeIdentifier::trivial, 0) | castAndShift(typeSize, 2)
+             | castAndShift(trivialType, 4);
+    }
+
     constexpr std::optional<std::pair<TrivialType,
                                       TypeSize>>
     parseTrivialTypeIdentifier(std::byte value) {
@@ -398,6 +466,171 @@ namespace remote_fmt { namespace detail {
         };
     }
 
+    // Trivial identifiers never set bit 7, and parseTrivialTypeIdentifier has always rejected one
+    // that did. That leaves a one-byte identifier space for encodings shorter than the general
+    // ones, which a parser that does not know them refuses instead of misreading.
+    //   Bit 7:    1
+    //   Bits 4-6: CompactType
+    //   Bits 2-3: TimeRepresentation for the std_ratio kinds, RangeSize of the payload for flags,
+    //             TypeSize of the count for drop_report
+    //   Bits 0-1: TypeIdentifier::trivial = 0b00
+    template<CompactType ct>
+    static constexpr std::byte TypeId_v<TypeIdentifier::trivial, ct>{
+      castAndShift(TypeIdentifier::trivial, 0) | castAndShift(ct, 4) | std::byte{0x80}};
+
+    constexpr bool isCompactTypeIdentifier(std::byte value) {
+        return parseTypeIdentifier(value) == TypeIdentifier::trivial
+            && (value & std::byte{0x80}) != std::byte{};
+    }
+
+    // A duration whose period is in std_ratios: the identifier, a one-byte index into std_ratios,
+    // then the count. Six bytes for an int32 microseconds count instead of ten.
+    template<TimeType timeType>
+    constexpr std::byte stdRatioTimeTypeIdentifier(TimeRepresentation rep) {
+        constexpr auto compactType = timeType == TimeType::duration
+                                     ? CompactType::std_ratio_duration
+                                     : CompactType::std_ratio_time_point;
+        return TypeId_v<TypeIdentifier::trivial, compactType> | castAndShift(rep, 2);
+    }
+
+    constexpr std::optional<std::pair<TimeType,
+                                      TimeRepresentation>>
+    parseStdRatioTimeTypeIdentifier(std::byte value) {
+        if(!isCompactTypeIdentifier(value)) { return std::nullopt; }
+
+        CompactType const compactType = static_cast<CompactType>((value & std::byte{0x70}) >> 4);
+        TimeRepresentation const timeRep
+          = static_cast<TimeRepresentation>((value & std::byte{0x0C}) >> 2);
+
+        if(compactType != CompactType::std_ratio_duration
+           && compactType != CompactType::std_ratio_time_point)
+        {
+            return std::nullopt;
+        }
+
+        if(value
+           != (detail::castAndShift(TypeIdentifier::trivial, 0)
+               | detail::castAndShift(static_cast<TimeRepresentation>(timeRep), 2)
+               | detail::castAndShift(static_cast<CompactType>(compactType), 4) | std::byte{0x80}))
+        {
+            return std::nullopt;
+        }
+
+        TimeType const timeType = compactType == CompactType::std_ratio_duration
+                                  ? TimeType::duration
+                                  : TimeType::time_point;
+        return {
+          {timeType, timeRep}
+        };
+    }
+
+    // Consecutive bool arguments of one format call, packed into a single value: bit i is the
+    // argument i places after the identifier, and a stop bit just above the last flag gives the
+    // count. One byte holds up to 7 flags, two bytes up to 15; longer runs take several groups.
+    // The group stands in for as many replacement fields as it holds flags.
+    static constexpr std::size_t Max_flags_per_group{15};
+
+    constexpr std::byte flagsTypeIdentifier(RangeSize rangeSize) {
+        return TypeId_v<TypeIdentifier::trivial, CompactType::flags> | castAndShift(rangeSize, 2);
+    }
+
+    constexpr std::optional<RangeSize> parseFlagsTypeIdentifier(std::byte value) {
+        if(!isCompactTypeIdentifier(value)) { return std::nullopt; }
+
+        CompactType const compactType = static_cast<CompactType>((value & std::byte{0x70}) >> 4);
+        if(compactType != CompactType::flags) { return std::nullopt; }
+
+        RangeSize const rangeSize = static_cast<RangeSize>((value & std::byte{0x04}) >> 2);
+        if(value != flagsTypeIdentifier(rangeSize)) { return std::nullopt; }
+        return rangeSize;
+    }
+
+    // Frames the device dropped for lack of transport capacity since the last one it sent. Never
+    // an argument: it sits between the start marker and the format string of the next frame that
+    // fits, followed by the count in the narrowest of 1, 2 or 4 bytes.
+    constexpr std::byte dropReportTypeIdentifier(TypeSize typeSize) {
+        return TypeId_v<TypeIdentifier::trivial, CompactType::drop_report>
+             | castAndShift(typeSize, 2);
+    }
+
+    constexpr std::optional<TypeSize> parseDropReportTypeIdentifier(std::byte value) {
+        if(!isCompactTypeIdentifier(value)) { return std::nullopt; }
+
+        CompactType const compactType = static_cast<CompactType>((value & std::byte{0x70}) >> 4);
+        if(compactType != CompactType::drop_report) { return std::nullopt; }
+
+        TypeSize const typeSize = static_cast<TypeSize>((value & std::byte{0x0C}) >> 2);
+        if(typeSize == TypeSize::_8) { return std::nullopt; }
+        return typeSize;
+    }
+
+    template<typename Append>
+    constexpr void appendDropReport(std::uint32_t count,
+                                    Append        append) {
+        auto const typeSize = sizeToTypeSize(count);
+        append(dropReportTypeIdentifier(typeSize));
+        appendSized(typeSize, count, append);
+    }
+
+    template<typename Append>
+    constexpr void appendFlags(std::uint16_t flags,
+                               std::size_t   count,
+                               Append        append) {
+        auto const packed = static_cast<std::uint16_t>(flags | (1U << count));
+        if(count < 8) {
+            append(flagsTypeIdentifier(RangeSize::_1), static_cast<std::uint8_t>(packed));
+        } else {
+            append(flagsTypeIdentifier(RangeSize::_2), packed);
+        }
+    }
+
+    // An aggregate goes out as its schema, a string, followed by its fields' payloads back to back
+    // and nothing else. The schema is "name:code" per field, comma separated, where the code is the
+    // field's trivial type as a letter and its byte size as a digit: "id:u2,gain:f4,on:b1". Being a
+    // string, it is cataloged once per struct type like any other.
+    inline constexpr std::string_view trivial_type_codes = "uibcpf";
+
+    constexpr std::array<char,
+                         2>
+    aggregateFieldCode(TrivialType trivialType,
+                       TypeSize    typeSize) {
+        return {trivial_type_codes[static_cast<std::size_t>(trivialType)],
+                static_cast<char>('0' + byteSize(typeSize))};
+    }
+
+    constexpr std::optional<std::pair<TrivialType,
+                                      TypeSize>>
+    parseAggregateFieldCode(std::string_view code) {
+        if(code.size() != 2) { return std::nullopt; }
+        auto const type = trivial_type_codes.find(code[0]);
+        if(type == std::string_view::npos) { return std::nullopt; }
+        for(auto const typeSize : {TypeSize::_1, TypeSize::_2, TypeSize::_4, TypeSize::_8}) {
+            if(code[1] == static_cast<char>('0' + byteSize(typeSize))) {
+                return {
+                  {static_cast<TrivialType>(type), typeSize}
+                };
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Bytes of the fields of an aggregate with this schema.
+    constexpr std::optional<std::size_t> aggregatePayloadSize(std::string_view schema) {
+        if(schema.empty()) { return std::nullopt; }
+        std::size_t size = 0;
+        while(true) {
+            auto const comma = schema.find(',');
+            auto const field = schema.substr(0, comma);
+            auto const colon = field.rfind(':');
+            if(colon == 0 || colon == std::string_view::npos) { return std::nullopt; }
+            auto const fieldType = parseAggregateFieldCode(field.substr(colon + 1));
+            if(!fieldType) { return std::nullopt; }
+            size += byteSize(fieldType->second);
+            if(comma == std::string_view::npos) { return size; }
+            schema = schema.substr(comma + 1);
+        }
+    }
+
     template<ExtendedTypeIdentifier eti,
              typename Append>
     void appendExtendedTypeIdentifier(Append append) {
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "remote_fmt/parser.hpp"
+#include "remote_fmt/type_identifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace remote_fmt {
+
+struct WireTally {
+    // Frames in the tally of a capture or a format string, values in the tally of a type.
+    std::uint64_t                                               count{};
+    std::array<std::uint64_t, enchantum::count<WireCategory>> bytes{};
+
+    std::uint64_t& operator[](WireCategory category) {
+        return bytes[static_cast<std::size_t>(category)];
+    }
+
+    std::uint64_t operator[](WireCategory category) const {
+        return bytes[static_cast<std::size_t>(category)];
+    }
+
+    std::uint64_t total() const {
+        return std::accumulate(bytes.begin(), bytes.end(), std::uint64_t{});
+    }
+
+    WireTally& operator+=(WireTally const& other) {
+        count += other.count;
+        std::ranges::transform(bytes, other.bytes, bytes.begin(), std::plus{});
+        return *this;
+    }
+};
+
+// Every byte of a parsed frame lands once in total and once in the tally of its frame's format
+// string. The argument tallies split the same bytes by type: an argument counts in full under
+// its outermost identifier, and every trivial value, at any depth, under its TrivialType with its
+// identifier. A duration with a standard ratio counts as TypeIdentifier::time and a group of
+// bools as TrivialType::boolean, although both are sent in the trivial identifier space.
+struct WireReport {
+    WireTally total;
+    // Frames whose format string went as a catalog id.
+    std::map<std::uint16_t, WireTally> by_catalog_id;
+    // Frames whose format string went as text, by that text.
+    std::map<std::string, WireTally, std::less<>> by_inline_format;
+
+    std::map<detail::TypeIdentifier, WireTally> by_type_identifier;
+    // Arguments that are ranges, strings or wrappers such as optional.
+    std::map<detail::RangeType, WireTally> by_range_type;
+    std::map<detail::TrivialType, WireTally> by_trivial_type;
+
+    // Between frames, and in frames the parser rejects.
+    std::uint64_t unparsed_bytes{};
+    std::uint64_t rejected_frames{};
+};
+
+namespace detail {
+
+    // What the parser reads for analyzeWire, added up one frame at a time and kept apart from
+    // the report until the parser has accepted the frame.
+    class WireTallies {
+    public:
+        void frame() {
+            pending   = {};
+            site      = std::nullopt;
+            arguments = 0;
+            argument  = nullptr;
+            range     = nullptr;
+        }
+
+        void fmtString(std::optional<std::uint16_t> id,
+                       std::string_view             text) {
+            if(!site) { site = Site{id, text}; }
+        }
+
+        // The argument tallies are those of the outermost argument, so that the arguments of a
+        // nested format string count towards the argument that carries it.
+        void enterArgument(std::byte   identifier,
+                           std::size_t values) {
+            if(arguments++ != 0) { return; }
+            if(parseFlagsTypeIdentifier(identifier)) {
+                argument = &pending.by_type_identifier[TypeIdentifier::trivial];
+                argument->count += values;
+                return;
+            }
+            auto const typeId = isCompactTypeIdentifier(identifier)
+                                ? TypeIdentifier::time
+                                : parseTypeIdentifier(identifier);
+            argument = &pending.by_type_identifier[typeId];
+            argument->count += values;
+            if(auto const rangeTypeId = parseRangeTypeIdentifier(identifier)) {
+                range = &pending.by_range_type[std::get<0>(*rangeTypeId)];
+                range->count += 1;
+            }
+        }
+
+        void leaveArgument() {
+            if(--arguments != 0) { return; }
+            argument = nullptr;
+            range    = nullptr;
+        }
+
+        void bytes(WireCategory category,
+                   std::size_t  bytes_) {
+            pending.total[category] += bytes_;
+            if(argument != nullptr) { (*argument)[category] += bytes_; }
+            if(range != nullptr) { (*range)[category] += bytes_; }
+        }
+
+        void trivial(TrivialType  trivialType,
+                     WireCategory category,
+                     std::size_t  bytes_,
+                     std::size_t  values) {
+            bytes(category, bytes_);
+            WireTally& tally = pending.by_trivial_type[trivialType];
+            tally[category] += bytes_;
+            tally.count += values;
+        }
+
+        // Adds the frame the parser has just accepted to report.
+        void addTo(WireReport& report) const {
+            WireTally frameTally = pending.total;
+            frameTally.count     = 1;
+            report.total += frameTally;
+            if(site->id) {
+                report.by_catalog_id[*site->id] += frameTally;
+            } else {
+                auto inlineFormat = report.by_inline_format.find(site->text);
+                if(inlineFormat == report.by_inline_format.end()) {
+                    inlineFormat = report.by_inline_format.emplace(site->text, WireTally{}).first;
+                }
+                inlineFormat->second += frameTally;
+            }
+            for(auto const& [typeId, tally] : pending.by_type_identifier) {
+                report.by_type_identifier[typeId] += tally;
+            }
+            for(auto const& [rangeType, tally] : pending.by_range_type) {
+                report.by_range_type[rangeType] += tally;
+            }
+            for(auto const& [trivialType, tally] : pending.by_trivial_type) {
+                report.by_trivial_type[trivialType] += tally;
+            }
+        }
+
+    private:
+        // The format string of the frame, which it is tallied under.
+        struct Site {
+            std::optional<std::uint16_t> id;
+            std::string_view             text;
+        };
+
+        // The frame being read. Its total is the frame's tally.
+        WireReport          pending;
+        std::optional<Site> site;
+        // Arguments currently entered, those of nested format strings included.
+        std::size_t         arguments{};
+        WireTally*          argument{};
+        WireTally*          range{};
+    };
+}   // namespace detail
+
+// Adds the complete frames at the front of buffer to report and returns the rest, which starts
+// with a frame that has not fully arrived yet. Frames the parser rejects, and bytes between
+// frames, only count as unparsed.
+inline std::span<std::byte const>
+analyzeWire(std::span<std::byte const>             buffer,
+            std::unordered_map<std::uint16_t,
+                               std::string> const& stringConstantsMap,
+            WireReport&                            report) {
+    detail::Parser<NullSink, detail::WireTallies> parser{NullSink{}};
+    NoStats                                        stats{};
+    while(!buffer.empty()) {
+        auto const [message, remaining, unparsed, info]
+          = detail::parseFrameWith(buffer, stringConstantsMap, parser, stats);
+        report.unparsed_bytes += unparsed;
+        if(!message) {
+            if(remaining.size() < 2
+               || std::ranges::find(remaining, protocol::End_marker) == remaining.end())
+            {
+                return remaining;
+            }
+            report.unparsed_bytes += 1;
+            report.rejected_frames += 1;
+            buffer = remaining.subspan(1);
+            continue;
+        }
+        parser.tally.addTo(report);
+        buffer = remaining;
+    }
+    return buffer;
+}
+
+// The report for a whole capture. A frame cut off at its end counts as unparsed.
+inline WireReport analyzeWire(std::span<std::byte const>             capture,
+                              std::unordered_map<std::uint16_t,
+                                                 std::string> const& stringConstantsMap) {
+    WireReport report{};
+    report.unparsed_bytes += analyzeWire(capture, stringConstantsMap, report).size();
+    return report;
+}
+}   // namespace remote_fmt
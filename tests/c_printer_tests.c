@@ -0,0 +1,57 @@
+/* The C half of test_c_printer: compiled as C, with nothing but c_printer.h. */
+#include "remote_fmt/c_printer.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+bool c_print_mixed(void);
+bool c_print_pointer(void const* pointer);
+bool c_print_invalid_size(void);
+bool c_print_field_mismatch(void);
+bool c_print_flags(void);
+
+bool c_print_mixed(void) {
+    uint16_t const channel = 7;
+    int32_t const  offset  = -42;
+    double const   voltage = 3.25;
+    bool const     enabled = true;
+    char const     axis    = 'x';
+
+    remote_fmt_arg const args[] = {REMOTE_FMT_ARG(REMOTE_FMT_UNSIGNED, channel),
+                                   REMOTE_FMT_ARG(REMOTE_FMT_SIGNED, offset),
+                                   REMOTE_FMT_ARG(REMOTE_FMT_FLOAT, voltage),
+                                   REMOTE_FMT_ARG(REMOTE_FMT_BOOL, enabled),
+                                   REMOTE_FMT_ARG(REMOTE_FMT_CHAR, axis),
+                                   REMOTE_FMT_STRING_ARG("pump")};
+    return remote_fmt_print("ch{} offset {} at {:.2f} V, enabled {} axis {} {}",
+                            args,
+                            sizeof args / sizeof args[0]);
+}
+
+bool c_print_pointer(void const* pointer) {
+    remote_fmt_arg const args[] = {REMOTE_FMT_ARG(REMOTE_FMT_POINTER, pointer)};
+    return remote_fmt_print("buffer {}", args, 1);
+}
+
+bool c_print_invalid_size(void) {
+    uint16_t const       value   = 1;
+    remote_fmt_arg const args[] = {{REMOTE_FMT_BOOL, sizeof value, &value}};
+    return remote_fmt_print("flag {}", args, 1);
+}
+
+bool c_print_field_mismatch(void) {
+    uint8_t const        value   = 1;
+    remote_fmt_arg const args[] = {REMOTE_FMT_ARG(REMOTE_FMT_UNSIGNED, value)};
+    return remote_fmt_print("{} and {}", args, 1);
+}
+
+bool c_print_flags(void) {
+    bool const           armed   = true;
+    bool const           tripped = false;
+    uint8_t const        zone    = 3;
+    remote_fmt_arg const args[]  = {REMOTE_FMT_ARG(REMOTE_FMT_BOOL, armed),
+                                    REMOTE_FMT_ARG(REMOTE_FMT_BOOL, tripped),
+                                    REMOTE_FMT_ARG(REMOTE_FMT_UNSIGNED, zone)};
+    return remote_fmt_print("armed {} tripped {} zone {}", args, 3);
+}
@@ -0,0 +1,142 @@
+// Tests for the C entry points of c_printer.h: c_printer_tests.c calls them as C code, and what
+// they send has to be byte for byte what Printer::print sends for the same values.
+#include "remote_fmt/c_printer.h"
+#include "remote_fmt/parser.hpp"
+#include "remote_fmt/remote_fmt.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace sc::literals;
+using namespace std::literals;
+
+extern "C" {
+bool c_print_mixed(void);
+bool c_print_pointer(void const* pointer);
+bool c_print_invalid_size(void);
+bool c_print_flags(void);
+bool c_print_field_mismatch(void);
+}
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, msg)                                        \
+    do {                                                        \
+        if(!(cond)) {                                           \
+            std::printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            ++failures;                                         \
+        }                                                       \
+    } while(0)
+
+struct VectorBackend {
+    std::vector<std::byte> memory;
+
+    void write(std::span<std::byte const> data) {
+        memory.insert(memory.end(), data.begin(), data.end());
+    }
+};
+
+// Leaked on purpose: avoids the global-constructor and exit-time-destructor warnings.
+remote_fmt::Printer<VectorBackend>& cPrinter() {
+    static auto& printer = *new remote_fmt::Printer<VectorBackend>{};
+    return printer;
+}
+
+std::vector<std::byte> takeOutput() {
+    std::vector<std::byte> output;
+    output.swap(cPrinter().get_com_backend().memory);
+    return output;
+}
+
+std::unordered_map<std::uint16_t,
+                   std::string> const&
+emptyCatalog() {
+    static auto const& catalog = *new std::unordered_map<std::uint16_t, std::string>{};
+    return catalog;
+}
+
+std::string parseOne(std::span<std::byte const> buffer) {
+    auto const [message, remaining, discarded]
+      = remote_fmt::parse(buffer, emptyCatalog(), [](std::string_view) {});
+    CHECK(remaining.empty() && discarded == 0, "buffer fully consumed");
+    return message.value_or("<no message>");
+}
+
+}   // namespace
+
+REMOTE_FMT_DEFINE_C_PRINTER(cPrinter())
+
+int main() {
+    {
+        CHECK(c_print_mixed(), "valid call accepted");
+        auto const fromC = takeOutput();
+        CHECK(parseOne(fromC) == "ch7 offset -42 at 3.25 V, enabled true axis x pump",
+              "C arguments round trip");
+
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print("ch{} offset {} at {:.2f} V, enabled {} axis {} {}"_sc,
+                      std::uint16_t{7},
+                      std::int32_t{-42},
+                      3.25,
+                      true,
+                      'x',
+                      "pump"sv);
+        CHECK(fromC == printer.get_com_backend().memory, "same bytes as print");
+    }
+
+    {
+        int         target{};
+        void const* pointer = &target;
+        CHECK(c_print_pointer(pointer), "pointer accepted");
+        auto const fromC = takeOutput();
+
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print("buffer {}"_sc, pointer);
+        CHECK(fromC == printer.get_com_backend().memory, "pointer sent like print sends it");
+    }
+
+    {
+        // Consecutive bools go out as one flags group, as print packs them.
+        CHECK(c_print_flags(), "bools accepted");
+        auto const fromC = takeOutput();
+        CHECK(parseOne(fromC) == "armed true tripped false zone 3", "bools round trip");
+
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print("armed {} tripped {} zone {}"_sc, true, false, std::uint8_t{3});
+        CHECK(fromC == printer.get_com_backend().memory, "bools packed like print packs them");
+    }
+
+    {
+        CHECK(!c_print_invalid_size(), "two byte bool rejected");
+        CHECK(!c_print_field_mismatch(), "field count mismatch rejected");
+        CHECK(takeOutput().empty(), "rejected calls send nothing");
+    }
+
+    {
+        // A null string is sent as an empty one.
+        remote_fmt_arg const args[] = {REMOTE_FMT_STRING_ARG(nullptr)};
+        CHECK(remote_fmt_print("[{}]", args, 1), "null string accepted");
+        CHECK(parseOne(takeOutput()) == "[]", "null string is empty");
+
+        CHECK(!remote_fmt_print("{}", nullptr, 0), "missing argument rejected");
+        CHECK(!remote_fmt_print("{0}", args, 1), "argument id rejected");
+        CHECK(!remote_fmt_print("tab\t{}", args, 1), "control character rejected");
+        CHECK(!remote_fmt_print("{:100000}", args, 1), "width above the host's limit rejected");
+        CHECK(takeOutput().empty(), "rejected calls send nothing");
+    }
+
+    if(failures != 0) {
+        std::printf("%d test(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all tests passed\n");
+    return 0;
+}
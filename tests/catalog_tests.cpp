@@ -6,7 +6,10 @@
 
 #include "remote_fmt/parser.hpp"
 #include "remote_fmt/remote_fmt.hpp"
+#include "remote_fmt/wire_report.hpp"
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
@@ -34,6 +37,43 @@ std::uint16_t remote_fmt::catalog<std::remove_cvref_t<decltype(argString)> const
     return 1;
 }
 
+// The bare "{}" a RepeatFilter's notices are sent under.
+template<>
+std::uint16_t remote_fmt::catalog<sc::StringConstant<'{', '}'>>() {
+    return 5;
+}
+
+// What C code calls to get the id of fmtString for remote_fmt_print_cataloged.
+extern "C" std::uint16_t test_fmt_id(void);
+REMOTE_FMT_DEFINE_C_CATALOG_ENTRY(test_fmt_id, "Test {}")
+
+struct Point {
+    std::int32_t x;
+    std::int32_t y;
+};
+
+// An aggregate's schema is a StringConstant argument like any other.
+template<>
+std::uint16_t remote_fmt::catalog<
+  std::remove_cvref_t<decltype(remote_fmt::detail::AggregateSchema<Point>::text)> const&>() {
+    return 6;
+}
+
+enum class Color : std::uint8_t { red, green, blue };
+enum class Level : std::uint8_t { debug, info };
+
+// An enum is cataloged as a table of its enumerator names: the id returned here belongs to the
+// first name, the others follow in enchantum::values order.
+template<>
+std::uint16_t remote_fmt::catalog<remote_fmt::detail::EnumNameTable<Color>::catalog_key>() {
+    return 2;
+}
+
+template<>
+std::uint16_t remote_fmt::catalog<remote_fmt::detail::EnumNameTable<Level>::catalog_key>() {
+    return 300;
+}
+
 namespace {
 
 int failures = 0;
@@ -46,6 +86,16 @@ int failures = 0;
         }                                                       \
     } while(0)
 
+struct SteadyClock {
+    using duration                  = std::chrono::milliseconds;
+    using rep                       = duration::rep;
+    using period                    = duration::period;
+    using time_point                = std::chrono::time_point<SteadyClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() { return {}; }
+};
+
 struct VectorBackend {
     std::vector<std::byte> memory;
 
@@ -59,8 +109,15 @@ std::unordered_map<std::uint16_t,
                    std::string> const&
 stringConstantsMap() {
     static auto const& map = *new std::unordered_map<std::uint16_t, std::string>{
-      {0, std::string{std::string_view{fmtString}}},
-      {1, std::string{std::string_view{argString}}}
+      {  0, std::string{std::string_view{fmtString}}},
+      {  1, std::string{std::string_view{argString}}},
+      {  2,                                    "red"},
+      {  3,                                  "green"},
+      {  4,                                   "blue"},
+      {  5,                                     "{}"},
+      {  6,                              "x:i4,y:i4"},
+      {300,                                  "debug"},
+      {301,                                   "info"}
     };
     return map;
 }
@@ -89,6 +146,48 @@ int main() {
         CHECK(message.has_value() && *message == "Test hello",
               "cataloged string argument resolves");
         CHECK(remaining.empty() && discarded == 0, "buffer fully consumed");
+
+        // Both strings are two byte ids, tallied under the id of the format string.
+        auto const report = remote_fmt::analyzeWire(std::span{buffer}, stringConstantsMap());
+        CHECK(report.total[remote_fmt::WireCategory::catalog_id] == 4, "ids in the wire report");
+        CHECK(report.total[remote_fmt::WireCategory::format_string] == 0, "no format string text");
+        CHECK(report.by_catalog_id.contains(0)
+                && report.by_catalog_id.at(0).total() == buffer.size(),
+              "frame tallied under its catalog id");
+    }
+
+    {
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print(fmtString, Color::green);
+        auto const& buffer = printer.get_com_backend().memory;
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, stringConstantsMap(), [](std::string_view) {});
+        CHECK(message.has_value() && *message == "Test green", "enum resolves through its table");
+        // Start marker, format string id, identifier and one-byte enum id, end marker.
+        CHECK(buffer.size() == 1 + 3 + 2 + 1, "enum id below 256 takes one byte");
+    }
+
+    {
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print(fmtString, Level::info);
+        auto const& buffer = printer.get_com_backend().memory;
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, stringConstantsMap(), [](std::string_view) {});
+        CHECK(message.has_value() && *message == "Test info", "wide enum id resolves");
+        CHECK(buffer.size() == 1 + 3 + 3 + 1, "enum id above 255 takes two bytes");
+    }
+
+    {
+        // A value outside the enumerators has no name and goes out as its underlying integer.
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print(fmtString, static_cast<Color>(7));
+        auto const& buffer = printer.get_com_backend().memory;
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, stringConstantsMap(), [](std::string_view) {});
+        CHECK(message.has_value() && *message == "Test 7", "unnamed enum value as integer");
     }
 
     {
@@ -106,6 +205,138 @@ int main() {
         CHECK(errorReported, "unknown catalog id reports an error");
     }
 
+    {
+        // A repeat notice names the format string by its id, like the frame it stands for.
+        using Filter = remote_fmt::RepeatFilter<SteadyClock>;
+        remote_fmt::Printer<VectorBackend, Filter> printer{Filter{std::chrono::milliseconds{10}}};
+        printer.print(fmtString, 42);
+        printer.print(fmtString, 42);
+        printer.flush_repeats();
+        auto const& buffer = printer.get_com_backend().memory;
+
+        auto const [first, rest, discarded]
+          = remote_fmt::parse(std::span{buffer}, stringConstantsMap(), [](std::string_view) {});
+        auto const [message, remaining, discarded2]
+          = remote_fmt::parse(rest, stringConstantsMap(), [](std::string_view) {});
+        CHECK(message.has_value() && *message == "\"Test {}\" repeated 1 time",
+              "cataloged repeat notice resolves");
+        CHECK(remaining.empty(), "buffer fully consumed");
+    }
+
+    {
+        // Call site commands switch the format string's id off and on again without touching the
+        // other ids.
+        using Printer = remote_fmt::Printer<VectorBackend>;
+        using remote_fmt::CallSiteCommand;
+        auto const off = remote_fmt::encodeCallSiteCommand({CallSiteCommand::disable, 0, 0});
+        CHECK(Printer::apply_call_site_command(off), "command accepted");
+        CHECK(!Printer::call_site_enabled(0) && Printer::call_site_enabled(1), "only id 0 disabled");
+
+        Printer printer{};
+        printer.print(fmtString, 42);
+        CHECK(printer.get_com_backend().memory.empty(), "disabled call site sends nothing");
+
+        auto const on = remote_fmt::encodeCallSiteCommand({CallSiteCommand::enable, 0, 0});
+        CHECK(Printer::apply_call_site_command(on), "command accepted");
+        printer.print(fmtString, 42);
+        auto const [message, remaining, discarded] = remote_fmt::parse(
+          std::span{printer.get_com_backend().memory},
+          stringConstantsMap(),
+          [](std::string_view) {});
+        CHECK(message.has_value() && *message == "Test 42", "re-enabled call site prints");
+    }
+
+    {
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print(fmtString, Point{3, -4});
+        auto const& buffer = printer.get_com_backend().memory;
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, stringConstantsMap(), [](std::string_view) {});
+        CHECK(message.has_value() && *message == "Test {x: 3, y: -4}",
+              "cataloged aggregate schema resolves");
+        // Start marker, format string id, extended identifier, schema id, payload, end marker.
+        CHECK(buffer.size() == 1 + 3 + 2 + 3 + 8 + 1, "schema costs three bytes");
+    }
+
+    {
+        // In a range the table id goes out once and each value as its index, names or not.
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print(fmtString,
+                      std::array{Color::blue, Color::red, static_cast<Color>(7), Color::green});
+        auto const& buffer = printer.get_com_backend().memory;
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, stringConstantsMap(), [](std::string_view) {});
+        CHECK(message.has_value() && *message == "Test [\"blue\", \"red\", 7, \"green\"]",
+              "enum range resolves through its table");
+        // Start marker, format string id, range header, extended identifier, index type, count,
+        // table id, one byte per value, end marker.
+        CHECK(buffer.size() == 1 + 3 + 2 + 2 + 1 + 2 + 2 + 4 + 1,
+              "enum range sends the table once");
+    }
+
+    {
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print(fmtString, std::vector<Point>{{1, 2}, {3, 4}});
+        auto const& buffer = printer.get_com_backend().memory;
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, stringConstantsMap(), [](std::string_view) {});
+        CHECK(message.has_value() && *message == "Test [{x: 1, y: 2}, {x: 3, y: 4}]",
+              "aggregate range resolves its cataloged schema");
+        CHECK(buffer.size() == 1 + 3 + 2 + 2 + 3 + 16 + 1, "aggregate range sends the schema once");
+    }
+
+    {
+        // The run-time entry point sends the id, and honours the call site bitmap like print.
+        using Printer = remote_fmt::Printer<VectorBackend>;
+        int const            value = 42;
+        remote_fmt_arg const args[] = {REMOTE_FMT_ARG(REMOTE_FMT_SIGNED, value)};
+
+        Printer runtime{};
+        CHECK(runtime.print_runtime(test_fmt_id(), args), "cataloged run-time print accepted");
+        Printer printer{};
+        printer.print(fmtString, 42);
+        CHECK(runtime.get_com_backend().memory == printer.get_com_backend().memory,
+              "same bytes as print");
+
+        Printer::set_call_sites({remote_fmt::CallSiteCommand::disable, 0, 0});
+        runtime.get_com_backend().memory.clear();
+        runtime.print_runtime(test_fmt_id(), args);
+        CHECK(runtime.get_com_backend().memory.empty(), "disabled id sends nothing");
+        Printer::set_call_sites({remote_fmt::CallSiteCommand::enable, 0, 0});
+    }
+
+    {
+        // Ranges across bitmap words, and ids past the bitmap, which stay enabled.
+        using Printer = remote_fmt::Printer<VectorBackend>;
+        Printer::set_call_sites({remote_fmt::CallSiteCommand::disable, 30, 1000});
+        CHECK(Printer::call_site_enabled(29), "below the range untouched");
+        CHECK(!Printer::call_site_enabled(30) && !Printer::call_site_enabled(32)
+                && !Printer::call_site_enabled(remote_fmt::call_site_slots - 1),
+              "range disabled across words");
+        CHECK(Printer::call_site_enabled(remote_fmt::call_site_slots), "past the bitmap enabled");
+
+        Printer::set_call_sites({remote_fmt::CallSiteCommand::enable, 31, 33});
+        CHECK(!Printer::call_site_enabled(30) && Printer::call_site_enabled(31)
+                && Printer::call_site_enabled(33) && !Printer::call_site_enabled(34),
+              "partial re-enable");
+        Printer::set_call_sites({remote_fmt::CallSiteCommand::enable, 0, 0xFFFF});
+        CHECK(Printer::call_site_enabled(30), "everything enabled again");
+    }
+
+    {
+        // Line noise must not switch sites off: a flipped bit fails the check byte.
+        auto packet = remote_fmt::encodeCallSiteCommand({remote_fmt::CallSiteCommand::disable, 0, 5});
+        auto const decoded = remote_fmt::decodeCallSiteCommand(packet);
+        CHECK(decoded && decoded->first == 0 && decoded->last == 5, "command round trip");
+        packet[3] ^= std::byte{0x01};
+        CHECK(!remote_fmt::Printer<VectorBackend>::apply_call_site_command(packet),
+              "corrupted command rejected");
+        CHECK(remote_fmt::Printer<VectorBackend>::call_site_enabled(0), "nothing changed");
+    }
+
     if(failures != 0) {
         std::printf("%d test(s) failed\n", failures);
         return 1;
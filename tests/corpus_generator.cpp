@@ -2,6 +2,7 @@
 // real Printer so the fuzzer starts from structurally valid protocol data.
 #include "remote_fmt/remote_fmt.hpp"
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <expected>
@@ -27,6 +28,13 @@ struct VectorBackend {
         memory.insert(memory.end(), data.begin(), data.end());
     }
 };
+
+struct Reading {
+    std::uint8_t channel;
+    float        value;
+};
+
+enum class Mode : std::uint8_t { off, on };
 }   // namespace
 
 int main(int    argc,
@@ -55,6 +63,8 @@ int main(int    argc,
     dump("plain"_sc);
     dump("Test {}"_sc, 123);
     dump("{} {} {}"_sc, -1, 2.5, true);
+    // Consecutive bools, packed into a flags group.
+    dump("{} {} {} {}"_sc, true, false, true, true);
     dump("{}"_sc, "a string"sv);
     dump("{}"_sc, std::vector<int>{1, 2, 3});
     dump("{}"_sc,
@@ -63,6 +73,13 @@ int main(int    argc,
            {3, 4}
     });
     dump("{}"_sc, std::tuple{1, 'c', "str"sv});
+    // Compact ranges whose element schema is a time or tuple header rather than one identifier.
+    dump("{}"_sc, std::vector<std::chrono::milliseconds>{1ms, 2ms});
+    dump("{}"_sc,
+         std::vector<std::pair<int, float>>{
+           {1, 1.5F},
+           {2, 2.5F}
+    });
     dump("{}"_sc, std::optional<int>{42});
     dump("{}"_sc, std::optional<int>{});
     dump("{}"_sc, std::expected<int, int>{std::unexpected{2}});
@@ -70,9 +87,22 @@ int main(int    argc,
     // Carries the ExtendedTypeIdentifier::variant marker, which no other seed reaches.
     dump("{}"_sc, std::variant<int, std::string_view>{7});
     dump("{}"_sc, std::variant<int, std::string_view>{"v"sv});
+    // A struct: its schema string, then the fields' bytes with no identifiers between them.
+    dump("{}"_sc, Reading{3, 1.5F});
+    // Compact ranges whose schema is a struct's, or an enum's table of names.
+    dump("{}"_sc,
+         std::vector<Reading>{
+           {1, 0.5F},
+           {2, 2.0F}
+    });
+    dump("{}"_sc, std::array{Mode::on, Mode::off, static_cast<Mode>(5)});
     dump("{}"_sc, std::chrono::milliseconds{123});
     dump("{}"_sc, std::chrono::duration<double>{1.5});
+    // A custom ratio, the only kind that still takes the full numerator/denominator encoding.
+    dump("{}"_sc, std::chrono::duration<std::int64_t, std::ratio<3, 7>>{5});
     dump("{:>10}"_sc, 7);
+    // What a RepeatFilter sends for held-back frames.
+    dump("{}"_sc, remote_fmt::detail::RepeatNotice{{"storm {}"sv, 0, false}, 3});
     dump("{}"_sc, fmt::styled(1, fmt::fg(fmt::color::red) | fmt::emphasis::bold));
     return 0;
 }
@@ -0,0 +1,181 @@
+// Tests for DmaBackend: a thread plays the DMA controller, copying every kicked buffer onto a
+// simulated wire and raising the completion interrupt afterwards. Whatever it sends has to parse
+// back into the printed messages, in order, with every frame either delivered or reported as
+// dropped.
+#include "remote_fmt/dma_backend.hpp"
+#include "remote_fmt/parser.hpp"
+#include "remote_fmt/remote_fmt.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace sc::literals;
+using namespace std::literals;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, msg)                                        \
+    do {                                                        \
+        if(!(cond)) {                                           \
+            std::printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            ++failures;                                         \
+        }                                                       \
+    } while(0)
+
+class SimulatedDma {
+public:
+    SimulatedDma() = default;
+
+    SimulatedDma(SimulatedDma const&)            = delete;
+    SimulatedDma& operator=(SimulatedDma const&) = delete;
+
+    ~SimulatedDma() { stop(); }
+
+    void start(std::function<void()>     complete_,
+               std::chrono::microseconds transferTime_) {
+        complete     = std::move(complete_);
+        transferTime = transferTime_;
+        worker       = std::thread{[this] { run(); }};
+    }
+
+    void stop() {
+        {
+            std::lock_guard const lock{mutex};
+            stopping = true;
+        }
+        wakeup.notify_one();
+        if(worker.joinable()) { worker.join(); }
+    }
+
+    void kick(std::span<std::byte const> data) {
+        {
+            std::lock_guard const lock{mutex};
+            if(job) { overlapping = true; }
+            job = data;
+        }
+        wakeup.notify_one();
+    }
+
+    // Only read after stop().
+    std::vector<std::byte> wire;
+    bool                   overlapping{};
+
+private:
+    void run() {
+        while(true) {
+            std::unique_lock lock{mutex};
+            wakeup.wait(lock, [&] { return job.has_value() || stopping; });
+            if(!job) { return; }
+            auto const data = *job;
+            lock.unlock();
+
+            std::this_thread::sleep_for(transferTime);
+            wire.insert(wire.end(), data.begin(), data.end());
+
+            lock.lock();
+            job.reset();
+            lock.unlock();
+            complete();
+        }
+    }
+
+    std::function<void()>                     complete;
+    std::chrono::microseconds                 transferTime{};
+    std::thread                               worker;
+    std::mutex                                mutex;
+    std::condition_variable                   wakeup;
+    std::optional<std::span<std::byte const>> job;
+    bool                                      stopping{};
+};
+
+std::unordered_map<std::uint16_t,
+                   std::string> const&
+emptyCatalog() {
+    static auto const& catalog = *new std::unordered_map<std::uint16_t, std::string>{};
+    return catalog;
+}
+
+template<typename Backend>
+bool waitIdle(Backend const& backend) {
+    auto const deadline = std::chrono::steady_clock::now() + 5s;
+    while(!backend.idle()) {
+        if(std::chrono::steady_clock::now() > deadline) { return false; }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// Prints count messages, then one more once the transport has drained, so that any drops get
+// reported. Every message is then found on the wire in order, or accounted for as dropped.
+template<std::size_t BufferSize,
+         std::size_t Buffers>
+void burst(std::size_t               count,
+           std::chrono::microseconds transferTime,
+           bool                      mustDrop) {
+    using Backend = remote_fmt::DmaBackend<SimulatedDma, BufferSize, Buffers>;
+    remote_fmt::Printer<Backend> printer{};
+    auto&                        backend = printer.get_com_backend();
+    backend.driver().start([&backend] { backend.on_complete(); }, transferTime);
+
+    for(std::size_t i = 0; i < count; ++i) { printer.print("msg {} {}"_sc, i, "payload"sv); }
+    CHECK(waitIdle(backend), "burst drains");
+    printer.print("msg {} {}"_sc, count, "payload"sv);
+    CHECK(waitIdle(backend), "last message drains");
+    backend.driver().stop();
+
+    CHECK(!backend.driver().overlapping, "one transfer at a time");
+
+    std::span<std::byte const> rest{backend.driver().wire};
+    std::size_t                delivered{};
+    std::size_t                dropped{};
+    std::size_t                last{};
+    bool                       ordered = true;
+    while(!rest.empty()) {
+        auto const [message, remaining, discarded, info]
+          = remote_fmt::parseFrame(rest, emptyCatalog(), [](std::string_view) {});
+        if(!message || discarded != 0) { break; }
+        std::size_t value{};
+        if(std::sscanf(message->c_str(), "msg %zu payload", &value) != 1) { break; }
+        ordered = ordered && (delivered == 0 || value > last);
+        last    = value;
+        dropped += info.dropped_before;
+        ++delivered;
+        rest = remaining;
+    }
+    CHECK(rest.empty(), "wire parses completely");
+    CHECK(ordered, "messages arrive in order");
+    CHECK(last == count, "last message delivered");
+    CHECK(delivered + dropped == count + 1, "every message delivered or reported dropped");
+    CHECK(!mustDrop || dropped != 0, "a transport that falls behind drops frames");
+}
+
+}   // namespace
+
+int main() {
+    // Fast transport: frames span buffers. Whether the thread keeps up is up to the scheduler.
+    burst<64, 2>(200, 0us, false);
+    burst<32, 4>(200, 0us, false);
+    // Slow transport and a burst larger than all buffers: whole frames drop and get reported.
+    burst<48, 3>(200, 2000us, true);
+
+    if(failures != 0) {
+        std::printf("%d test(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all tests passed\n");
+    return 0;
+}
@@ -76,6 +76,10 @@ void failCase() {
         #error "case 13 needs the full check (fmt/std.h); not applicable here"
     #endif
 
+#elif REMOTE_FMT_FAIL_CASE == 14
+    // a level prefix on an unleveled print: the host would read it as the message's Level
+    remote_fmt::checkFormatString<int>("\x12{}"_sc);
+
 #else
     #error "REMOTE_FMT_FAIL_CASE must name a case defined in this file"
 #endif
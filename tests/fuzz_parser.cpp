@@ -41,7 +41,7 @@ extern "C" int LLVMFuzzerTestOneInput(std::uint8_t const* data,
 
     while(!buffer.empty()) {
         auto const [message, remaining, discarded]
-          = remote_fmt::parse(buffer, stringConstantsMap, [](std::string_view) {});
+          = remote_fmt::parse(buffer, stringConstantsMap, remote_fmt::NullSink{});
         static_cast<void>(message);
         static_cast<void>(discarded);
         if(remaining.size() == buffer.size()) { break; }
@@ -156,8 +156,9 @@ std::optional<std::string> roundTrip(auto fmtString,
     printer.print(fmtString, std::forward<Args>(args)...);
     auto const& memory = printer.get_com_backend().memory;
     auto const [message, remaining, discarded]
-      = remote_fmt::parse(std::span<std::byte const>{memory}, emptyCatalog(), [](std::string_view) {
-        });
+      = remote_fmt::parse(std::span<std::byte const>{memory},
+                          emptyCatalog(),
+                          remote_fmt::NullSink{});
     // A message the Printer just produced must be consumed whole: anything left over or
     // skipped means the framing disagrees with itself.
     if(!remaining.empty() || discarded != 0) { return std::nullopt; }
@@ -210,7 +211,7 @@ std::vector<T> takeVector(Reader& reader) {
 // fill in the values. Keeping the selector first means the mutator's byte flips move
 // between shapes cheaply while splices keep a shape and rewrite its payload.
 void oneMessage(Reader& reader) {
-    switch(reader.byte() % 55U) {
+    switch(reader.byte() % 56U) {
         // --- trivial types, every width the protocol encodes -----------------------
     case 0:  CHECK_FMT("{}", reader.take<std::uint8_t>()); break;
     case 1:  CHECK_FMT("{}", reader.take<std::uint16_t>()); break;
@@ -533,6 +534,26 @@ void oneMessage(Reader& reader) {
         }
         break;
 
+        // --- consecutive bools travel as one flags group: nine of them need the two-byte form,
+        //     and the specs in between must still land on the right flag ------------------
+    case 54:
+        {
+            auto const bits = reader.take<std::uint16_t>();
+            auto const flag = [&](unsigned index) { return ((bits >> index) & 1U) != 0; };
+            CHECK_FMT("{} {:d} {}|{:>6}{} {} {:x} {} {}/{}",
+                      flag(0),
+                      flag(1),
+                      flag(2),
+                      flag(3),
+                      flag(4),
+                      flag(5),
+                      flag(6),
+                      flag(7),
+                      flag(8),
+                      bits);
+        }
+        break;
+
         // --- no arguments at all: spelled out rather than via CHECK_FMT, which needs at
         //     least one argument for its pack ---------------------------------------
     default:
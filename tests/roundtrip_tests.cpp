@@ -4,14 +4,20 @@
 #include "remote_fmt/parser.hpp"
 #include "remote_fmt/remote_fmt.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <expected>
+#include <forward_list>
+#include <initializer_list>
 #include <map>
+#include <numeric>
 #include <optional>
+#include <ranges>
 #include <set>
 #include <span>
 #include <string>
@@ -45,6 +51,18 @@ struct VectorBackend {
     }
 };
 
+// For staticPrint, which needs a static write. Leaked like emptyCatalog below.
+struct StaticBackend {
+    static std::vector<std::byte>& memory() {
+        static auto& bytes = *new std::vector<std::byte>{};
+        return bytes;
+    }
+
+    static void write(std::span<std::byte const> data) {
+        memory().insert(memory().end(), data.begin(), data.end());
+    }
+};
+
 // Leaked on purpose: avoids the global-constructor and exit-time-destructor warnings.
 std::unordered_map<std::uint16_t,
                    std::string> const&
@@ -104,6 +122,22 @@ std::vector<std::byte> rawStringFrame(std::string_view fmtString,
     return buffer;
 }
 
+// A "{}" format string followed by argument bytes as given, for identifiers and payloads the
+// Printer never sends.
+std::vector<std::byte> rawArgumentFrame(std::initializer_list<std::byte> argument) {
+    std::vector<std::byte> buffer;
+    buffer.push_back(remote_fmt::protocol::Start_marker);
+    buffer.push_back(
+      remote_fmt::detail::fmtStringTypeIdentifier<remote_fmt::detail::FmtStringType::normal>(
+        remote_fmt::detail::RangeSize::_1));
+    buffer.push_back(std::byte{2});
+    buffer.push_back(std::byte{'{'});
+    buffer.push_back(std::byte{'}'});
+    buffer.insert(buffer.end(), argument);
+    buffer.push_back(remote_fmt::protocol::End_marker);
+    return buffer;
+}
+
 template<typename... Args>
 std::optional<std::string> roundTrip(auto fmtString,
                                      Args&&... args) {
@@ -198,6 +232,12 @@ void stringRoundTrips() {
     CHECK_RT("string", "{}"_sc, std::string{"string"});
     CHECK_RT("red", "{}"_sc, Color::red);
     CHECK_RT("42", "{}"_sc, static_cast<Color>(42));
+
+    // Strings are formatted straight from the buffer being parsed, under every spec.
+    std::string const large(60000, 'x');
+    CHECK_PARITY("{}", large);
+    CHECK_PARITY("{:.3}|{:>6}", large, "ab"sv);
+    CHECK_PARITY("{}", std::vector<std::string>{large.substr(0, 300), ""});
 }
 
 void rangeRoundTrips() {
@@ -286,6 +326,362 @@ void timeRoundTrips() {
     }
 }
 
+// A period from std_ratios travels as a one-byte index rather than as numerator and denominator;
+// only a custom ratio still pays for both.
+void compactTimeEncoding() {
+    // Frame overhead: start marker, fmt-string id, length, "{}", end marker.
+    constexpr std::size_t frame = 6;
+
+    CHECK(serialize("{}"_sc, std::chrono::microseconds{5}).size() == frame + 1 + 1 + 4,
+          "microseconds: identifier, ratio index, int32 count");
+    CHECK(serialize("{}"_sc, std::chrono::nanoseconds{1LL << 40}).size() == frame + 1 + 1 + 8,
+          "nanoseconds: identifier, ratio index, int64 count");
+    CHECK(serialize("{}"_sc, std::chrono::duration<std::int64_t, std::ratio<3, 7>>{5}).size()
+            == frame + 1 + 1 + 1 + 4,
+          "custom ratio: identifier, numerator, denominator, count");
+
+    CHECK_PARITY("{}", std::chrono::microseconds{5});
+    CHECK_PARITY("{}", std::chrono::minutes{-7});
+    CHECK_PARITY("{}", std::chrono::days{3});
+    CHECK_PARITY("{}", (std::chrono::duration<float, std::milli>{0.25F}));
+
+    // An index past the end of std_ratios is refused, not read out of bounds.
+    {
+        auto const buffer = rawArgumentFrame(
+          {remote_fmt::detail::stdRatioTimeTypeIdentifier<remote_fmt::detail::TimeType::duration>(
+             remote_fmt::detail::TimeRepresentation::_int32),
+           static_cast<std::byte>(std::tuple_size_v<remote_fmt::detail::std_ratios>),
+           std::byte{},
+           std::byte{},
+           std::byte{},
+           std::byte{}});
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, emptyCatalog(), [](std::string_view) {});
+        CHECK(!message, "ratio index out of range refused");
+    }
+}
+
+void packedFlags() {
+    // Frame overhead without the format string: start marker, fmt-string id, length, end marker.
+    constexpr std::size_t frame = 4;
+
+    CHECK(serialize("{}{}{}{}"_sc, true, false, true, true).size() == frame + 8 + 1 + 1,
+          "four bools: identifier and one packed byte");
+    CHECK(serialize("{}{}{}{}{}{}{}{}"_sc, true, true, true, true, true, true, true, true).size()
+            == frame + 16 + 1 + 2,
+          "eight bools: identifier and two packed bytes");
+    CHECK(serialize("{}"_sc, true).size() == frame + 2 + 1 + 1,
+          "a lone bool keeps the trivial encoding");
+
+    CHECK_PARITY("{} {} {} {}", true, false, true, true);
+    CHECK_PARITY("a{}b{:d}c{:>6}d", false, true, false);
+    CHECK_PARITY("{} {} {}", true, 3, false);
+    CHECK_PARITY("{}{}{}{}{}{}{}{}{}",
+                 true,
+                 false,
+                 false,
+                 true,
+                 true,
+                 false,
+                 true,
+                 false,
+                 true);
+    // Sixteen in a row split into a group of fifteen and a lone bool.
+    CHECK_PARITY("{}{}{}{}{}{}{}{}{}{}{}{}{}{}{}{}",
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 true,
+                 false,
+                 true);
+
+    // A group claiming more flags than the format string has fields is refused.
+    {
+        auto const buffer = rawArgumentFrame(
+          {remote_fmt::detail::flagsTypeIdentifier(remote_fmt::detail::RangeSize::_1),
+           std::byte{0b100}});
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, emptyCatalog(), [](std::string_view) {});
+        CHECK(!message, "flags group longer than the format string refused");
+    }
+}
+
+void schemaRanges() {
+    // Frame overhead: start marker, fmt-string id, length, "{}", end marker.
+    constexpr std::size_t frame = 6;
+
+    CHECK(serialize("{}"_sc, std::vector<std::chrono::milliseconds>{1ms, 2ms, 3ms}).size()
+            == frame + 2 + 2 + (3 * 4),
+          "durations: range header, time header once, int32 counts");
+    CHECK(serialize("{}"_sc,
+                    std::vector<std::pair<int, float>>{
+                      {1, 1.5F},
+                      {2, 2.5F}
+    })
+              .size()
+            == frame + 2 + (2 + 1 + 1) + (2 * 8),
+          "pairs: range header, tuple and element identifiers once, payloads");
+
+    CHECK_PARITY("{}", std::vector<std::chrono::milliseconds>{1ms, 2ms, 3ms});
+    CHECK_PARITY("{}", std::vector<std::chrono::milliseconds>{1ms, std::chrono::milliseconds{1LL << 40}});
+    CHECK_PARITY("{}", std::vector<std::chrono::duration<double>>{1.5s, 2.25s});
+    CHECK_PARITY("{}",
+                 std::vector<std::chrono::duration<int, std::ratio<3, 7>>>{
+                   std::chrono::duration<int, std::ratio<3, 7>>{4}});
+    CHECK_PARITY("{::%S}", std::vector<std::chrono::seconds>{1s, 70s});
+    CHECK_PARITY("{}",
+                 std::vector<std::pair<int, float>>{
+                   {1, 1.5F},
+                   {2, 2.5F}
+    });
+    CHECK_PARITY("{}",
+                 std::map<int, int>{
+                   {1, 2},
+                   {3, 4}
+    });
+    CHECK_PARITY("{}",
+                 std::vector<std::tuple<int, char, std::pair<bool, double>>>{
+                   {1, 'a', {true, 0.5}},
+                   {2, 'b', {false, 1.5}}
+    });
+    CHECK_PARITY("{}", std::vector<std::pair<int, float>>{});
+
+    // Only trivial, time, tuple, aggregate and enumeration identifiers make up a schema; a string
+    // is refused.
+    {
+        auto const buffer = rawArgumentFrame(
+          {remote_fmt::detail::rangeTypeIdentifier<remote_fmt::detail::RangeType::list,
+                                                   remote_fmt::detail::RangeLayout::compact>(
+             remote_fmt::detail::RangeSize::_1),
+           std::byte{1},
+           remote_fmt::detail::rangeTypeIdentifier<remote_fmt::detail::RangeType::string,
+                                                   remote_fmt::detail::RangeLayout::compact>(
+             remote_fmt::detail::RangeSize::_1),
+           std::byte{1},
+           std::byte{'x'}});
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, emptyCatalog(), [](std::string_view) {});
+        CHECK(!message, "string as element schema refused");
+    }
+}
+
+struct Sample {
+    std::uint16_t id;
+    float         gain;
+    bool          enabled;
+    char          axis;
+};
+
+struct Point {
+    std::int32_t x;
+    std::int32_t y;
+};
+
+struct Mixed {
+    Color       color;
+    void const* where;
+    double      value;
+};
+
+static_assert(!remote_fmt::detail::AggregateSchema<Sample>::contiguous);
+static_assert(remote_fmt::detail::AggregateSchema<Point>::contiguous);
+static_assert(!remote_fmt::detail::is_scalar_aggregate<std::pair<int, int>>);
+static_assert(!remote_fmt::detail::is_scalar_aggregate<std::array<int, 2>>);
+
+void aggregateRoundTrips() {
+    CHECK_RT("{id: 7, gain: 1.5, enabled: true, axis: 'x'}", "{}"_sc, Sample{7, 1.5F, true, 'x'});
+    CHECK_RT("{x: -1, y: 2}", "{}"_sc, Point{-1, 2});
+    CHECK_RT("{color: 2, where: 0x1234, value: 0.25}",
+             "{}"_sc,
+             Mixed{Color::blue, std::bit_cast<void const*>(std::uintptr_t{0x1234}), 0.25});
+    CHECK_RT("x: -1, y: 2", "{:n}"_sc, Point{-1, 2});
+    CHECK_RT("{x: 0001, y: 0002}", "{::04}"_sc, Point{1, 2});
+    CHECK_RT("[{x: 1, y: 2}, {x: 3, y: 4}]",
+             "{}"_sc,
+             std::vector<Point>{
+               {1, 2},
+               {3, 4}
+    });
+    CHECK_RT("optional({x: 1, y: 2})", "{}"_sc, std::optional{Point{1, 2}});
+
+    // Frame overhead: start marker, fmt-string id, length, "{}", end marker. Then the extended
+    // identifier, the schema as an inline string here, and the bare payload.
+    constexpr std::size_t frame = 6;
+    CHECK(serialize("{}"_sc, Point{1, 2}).size() == frame + 2 + (2 + "x:i4,y:i4"sv.size()) + 8,
+          "aggregate: schema once, no identifier per field");
+    CHECK(serialize("{}"_sc, Sample{7, 1.5F, true, 'x'}).size()
+            == frame + 2 + (2 + "id:u2,gain:f4,enabled:b1,axis:c1"sv.size()) + 8,
+          "padding is not sent");
+
+    // A schema naming a type code the parser does not know is refused.
+    {
+        auto       buffer = serialize("{}"_sc, Point{1, 2});
+        auto const code   = std::ranges::search(buffer, std::array{std::byte{'i'}, std::byte{'4'}});
+        CHECK(!code.empty(), "schema found in the frame");
+        if(!code.empty()) { code.front() = std::byte{'q'}; }
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, emptyCatalog(), [](std::string_view) {});
+        CHECK(!message, "unknown field type refused");
+    }
+}
+
+struct CountingBackend {
+    std::size_t writes = 0;
+
+    void write(std::span<std::byte const>) { ++writes; }
+};
+
+template<typename Range>
+std::size_t backendWrites(Range const& range) {
+    remote_fmt::Printer<CountingBackend> printer{};
+    printer.print("{}"_sc, range);
+    return printer.get_com_backend().writes;
+}
+
+// Element types with a fixed-size encoding besides the trivial ones: their ranges are compact, and
+// contiguous ones go out in one copy whenever the payload is the element's own bytes.
+void bulkRanges() {
+    constexpr std::size_t frame = 6;
+
+    CHECK_RT("[\"red\", \"blue\", 9, \"green\"]",
+             "{}"_sc,
+             std::array{Color::red, Color::blue, static_cast<Color>(9), Color::green});
+    CHECK_RT("[  red,     9]", "{::>5}"_sc, std::vector<Color>{Color::red, static_cast<Color>(9)});
+    // Extended identifier, index type, count, the names as one string, then a byte per value.
+    CHECK(serialize("{}"_sc, std::array<Color, 64>{}).size()
+            == frame + 2 + (2 + 1 + 2 + (2 + "red,green,blue"sv.size())) + 64,
+          "enums: names once, then the raw values");
+
+    CHECK_RT("[0x10, 0x20]",
+             "{}"_sc,
+             std::vector<void const*>{std::bit_cast<void const*>(std::uintptr_t{0x10}),
+                                      std::bit_cast<void const*>(std::uintptr_t{0x20})});
+    CHECK(serialize("{}"_sc, std::vector<void const*>(3)).size()
+            == frame + 2 + 1 + (3 * sizeof(std::uintptr_t)),
+          "pointers: one identifier");
+
+    CHECK_RT("[{x: 1, y: 2}, {x: 3, y: 4}]",
+             "{}"_sc,
+             std::array{
+               Point{1, 2},
+               Point{3, 4}
+    });
+    CHECK_RT("[{id: 1, gain: 0.5, enabled: false, axis: 'a'}, {id: 2, gain: 1, enabled: true, "
+             "axis: 'b'}]",
+             "{}"_sc,
+             std::vector<Sample>{
+               {1, 0.5F, false, 'a'},
+               {2, 1.0F,  true, 'b'}
+    });
+    CHECK_RT("[(1, {x: 1, y: 2})]", "{}"_sc, std::vector<std::pair<int, Point>>{{1, {1, 2}}});
+    CHECK(serialize("{}"_sc, std::vector<Point>(5)).size()
+            == frame + 2 + (2 + (2 + "x:i4,y:i4"sv.size())) + (5 * 8),
+          "structs: schema once, then the fields");
+
+    CHECK_PARITY("{}", std::vector<std::chrono::duration<std::int32_t, std::milli>>{1ms, 2ms});
+    constexpr std::chrono::microseconds wide{1LL << 40};
+    CHECK_PARITY("{}", std::vector<std::chrono::microseconds>{1us, wide});
+
+    // Compact integer ranges under "{}" and the plain hex specs are formatted in one pass over the
+    // payload rather than element by element; every width, sign and spec it takes has to match.
+    std::vector<std::uint8_t> bytes(4096);
+    std::iota(bytes.begin(), bytes.end(), std::uint8_t{});
+    CHECK_PARITY("{}", bytes);
+    CHECK_PARITY("{::x}", bytes);
+    CHECK_PARITY("{::#X}", bytes);
+    CHECK_PARITY("{::04x}", std::vector<std::uint16_t>{0, 0xbeef, 0xffff});
+    CHECK_PARITY("{::#06x}", std::vector<std::uint16_t>{1, 0x1234});
+    CHECK_PARITY("{::#010X}", std::vector<std::int32_t>{-1, 0xabc, INT32_MIN});
+    CHECK_PARITY("{}", std::vector<std::int8_t>{-128, -1, 0, 127});
+    CHECK_PARITY("{}", std::vector<std::int16_t>{-32768, 42});
+    CHECK_PARITY("{}", std::vector<std::int64_t>{INT64_MIN, INT64_MAX});
+    CHECK_PARITY("{::x}", std::vector<std::int64_t>{INT64_MIN, -255});
+    CHECK_PARITY("{}", std::vector<std::uint64_t>{UINT64_MAX, 0});
+    CHECK_PARITY("{:n}", std::vector<std::uint32_t>{7, 8});
+    CHECK_PARITY("{}", std::vector<std::uint32_t>{});
+    // Specs outside that set still go element by element.
+    CHECK_PARITY("{::08b}", std::vector<std::uint8_t>{5, 200});
+    CHECK_PARITY("{::0x}", std::vector<std::uint8_t>{5, 200});
+    CHECK_PARITY("{::>4}", std::vector<std::int16_t>{-5, 7});
+
+    // The count of backend writes does not grow with the range when it goes out in one copy.
+    CHECK(backendWrites(std::array<Color, 64>{}) == backendWrites(std::array<Color, 2>{}),
+          "enums in one copy");
+    CHECK(backendWrites(std::vector<Point>(64)) == backendWrites(std::vector<Point>(2)),
+          "padding-free structs in one copy");
+    CHECK(backendWrites(std::vector<std::chrono::duration<float>>(64))
+            == backendWrites(std::vector<std::chrono::duration<float>>(2)),
+          "float durations in one copy");
+    CHECK(backendWrites(std::vector<std::chrono::microseconds>(64, wide))
+            == backendWrites(std::vector<std::chrono::microseconds>(2, wide)),
+          "int64 durations that need int64 in one copy");
+    CHECK(backendWrites(std::vector<Sample>(64)) != backendWrites(std::vector<Sample>(2)),
+          "padded structs field by field");
+}
+
+// A range that does not know its size is sent exactly like a sized one with the same elements.
+// It is walked once when its elements fit the staging buffer, twice otherwise.
+void unsizedRanges() {
+    std::vector<int> const numbers{1, 2, 3, 4, 5, 6};
+    std::size_t            calls = 0;
+    auto const             even  = [&](int value) {
+        ++calls;
+        return value % 2 == 0;
+    };
+
+    CHECK_RT("[2, 4, 6]", "{}"_sc, numbers | std::views::filter(even));
+    // A fresh view: filter_view remembers where it begins once it has been walked.
+    calls = 0;
+    CHECK(serialize("{}"_sc, numbers | std::views::filter(even))
+            == serialize("{}"_sc, std::vector{2, 4, 6}),
+          "filtered ints: same bytes as a vector");
+    if constexpr(remote_fmt::range_staging_size != 0) {
+        CHECK(calls == numbers.size(), "filtered range walked once");
+    }
+
+    std::forward_list<std::string_view> const words{"a", "bc"};
+    CHECK_RT("[\"a\", \"bc\"]", "{}"_sc, words);
+    CHECK(serialize("{}"_sc, words) == serialize("{}"_sc, std::vector<std::string_view>{"a", "bc"}),
+          "list: same bytes as a vector");
+
+    std::vector<Point> const points{
+      {1, 2},
+      {3, 4}
+    };
+    auto const positive = [](Point const& point) { return point.x > 1; };
+    CHECK_RT("[{x: 3, y: 4}]", "{}"_sc, points | std::views::filter(positive));
+
+    // A State has to be gathered before the first element, so these are counted first.
+    std::vector<std::chrono::milliseconds> const times{1ms, 2ms, 3ms};
+    auto const notTwo = [](std::chrono::milliseconds time) { return time != 2ms; };
+    CHECK(serialize("{}"_sc, times | std::views::filter(notTwo))
+            == serialize("{}"_sc, std::vector{1ms, 3ms}),
+          "filtered durations: same bytes as a vector");
+
+    // More than the staging buffer holds.
+    std::vector<std::int64_t> many(200);
+    std::iota(many.begin(), many.end(), 0);
+    auto const all = [](std::int64_t) { return true; };
+    CHECK(serialize("{}"_sc, many | std::views::filter(all)) == serialize("{}"_sc, many),
+          "overflowing the staging buffer falls back to counting");
+    CHECK(serialize("{}"_sc, std::views::filter(std::vector<int>{}, all)).size()
+            == serialize("{}"_sc, std::vector<int>{}).size(),
+          "empty filtered range");
+}
+
 // Strings and chars nested in a range or tuple carry fmt's debug format: quoted, with control
 // bytes and invalid UTF-8 escaped, and valid UTF-8 passed through. An explicit nested spec turns
 // the debug format off, exactly as it does in fmt. Every expectation here is fmt's own output for
@@ -428,6 +824,16 @@ void fmtParityScalars() {
     CHECK_PARITY("{}", std::numeric_limits<std::int64_t>::min());
     CHECK_PARITY("{}", std::numeric_limits<std::int64_t>::max());
 
+    // "{}" and the plain hex specs skip fmt on the host; these are the edges of what they take.
+    CHECK_PARITY("{:x}", std::uint8_t{0});
+    CHECK_PARITY("{:X}", std::uint32_t{0xdeadbeefU});
+    CHECK_PARITY("{:#x}", std::numeric_limits<std::uint64_t>::max());
+    CHECK_PARITY("{:08x}", std::uint16_t{0xabc});
+    CHECK_PARITY("{:#010X}", std::int32_t{-0x1f});
+    CHECK_PARITY("{:02x}", std::uint32_t{0x12345});
+    CHECK_PARITY("{:x}", std::numeric_limits<std::int64_t>::min());
+    CHECK_PARITY("{:#x}", std::int8_t{-128});
+
     CHECK_PARITY("{}", true);
     CHECK_PARITY("{}", false);
     CHECK_PARITY("{}", 'x');
@@ -463,12 +869,18 @@ void fmtParityFloats() {
         CHECK_PARITY("{:a}", value);
         CHECK_PARITY("{:.17g}", value);
         CHECK_PARITY("{:.0f}", value);
+        CHECK_PARITY("{:.2f}", value);
+        CHECK_PARITY("{:.17f}", value);
     }
 
     for(float const value : {0.0F, -1.5F, 1.0F / 3.0F, 3.4028235e38F, 1.17549435e-38F}) {
         CHECK_PARITY("{}", value);
         CHECK_PARITY("{:e}", value);
+        CHECK_PARITY("{:.3f}", value);
     }
+    // Exact halves round to even, on the exact binary value.
+    CHECK_PARITY("{:.2f} {:.2f} {:.1f}", 0.125, 0.375F, 2.25);
+    CHECK_PARITY("{:.2f}", 1.005);
 
     auto const inf = std::numeric_limits<double>::infinity();
     auto const nan = std::numeric_limits<double>::quiet_NaN();
@@ -477,6 +889,7 @@ void fmtParityFloats() {
     CHECK_PARITY("{}", nan);
     CHECK_PARITY("{:>10}", inf);
     CHECK_PARITY("{:+}", inf);
+    CHECK_PARITY("{:.2f} {:.2f} {:.2f}", inf, -inf, nan);
     CHECK_PARITY("{}", std::numeric_limits<float>::infinity());
     CHECK_PARITY("{}", std::numeric_limits<float>::quiet_NaN());
 }
@@ -856,6 +1269,291 @@ void multipleMessages() {
     CHECK(discarded2 == 0, "no bytes discarded before second message");
 }
 
+struct QuietModule {};
+
+}   // namespace
+
+template<>
+constexpr remote_fmt::Level remote_fmt::tag_min_level<QuietModule> = remote_fmt::Level::warning;
+
+namespace {
+
+void leveledPrint() {
+    using remote_fmt::Level;
+
+    auto parseLevel = [](std::vector<std::byte> const& buffer) {
+        return remote_fmt::parseWithLevel(std::span{buffer}, emptyCatalog(), [](std::string_view) {});
+    };
+
+    {
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print<Level::warning>("level {}"_sc, 1);
+        auto const [message, remaining, discarded, level] = parseLevel(printer.get_com_backend().memory);
+        CHECK(message.has_value() && *message == "level 1", "leveled message formats");
+        CHECK(level == Level::warning, "level reaches the host");
+    }
+    {
+        // The check runs on the format string as written, not on the one with the prefix.
+        remote_fmt::Printer<StaticBackend>::staticPrint<Level::error>("static {}"_sc, 2);
+        auto const [message, remaining, discarded, level] = parseLevel(StaticBackend::memory());
+        CHECK(message.has_value() && *message == "static 2", "leveled staticPrint formats");
+        CHECK(level == Level::error, "staticPrint level reaches the host");
+        StaticBackend::memory().clear();
+    }
+    {
+        auto const [message, remaining, discarded, level] = parseLevel(serialize("plain {}"_sc, 1));
+        CHECK(message.has_value() && !level, "unleveled message has no level");
+    }
+    {
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print<Level::info, QuietModule>("quiet {}"_sc, 1);
+        CHECK(printer.get_com_backend().memory.empty(), "below the tag threshold nothing is sent");
+        printer.print<Level::error, QuietModule>("quiet {}"_sc, 1);
+        CHECK(!printer.get_com_backend().memory.empty(), "above the tag threshold it is sent");
+    }
+    {
+        remote_fmt::Printer<VectorBackend>::set_runtime_level(Level::error);
+        remote_fmt::Printer<VectorBackend> printer{};
+        printer.print<Level::warning>("runtime {}"_sc, 1);
+        CHECK(printer.get_com_backend().memory.empty(), "below the runtime threshold nothing is sent");
+        printer.print<Level::critical>("runtime {}"_sc, 1);
+        CHECK(!printer.get_com_backend().memory.empty(), "above the runtime threshold it is sent");
+        remote_fmt::Printer<VectorBackend>::set_runtime_level(Level::trace);
+    }
+
+    // The level prefix only belongs in front of a whole message; a sub format string with one is
+    // refused like any other control character.
+    {
+        auto const buffer = rawArgumentFrame(
+          {remote_fmt::detail::fmtStringTypeIdentifier<remote_fmt::detail::FmtStringType::sub>(
+             remote_fmt::detail::RangeSize::_1),
+           std::byte{2},
+           static_cast<std::byte>(remote_fmt::detail::Level_prefix_base),
+           std::byte{'x'}});
+
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, emptyCatalog(), [](std::string_view) {});
+        CHECK(!message, "level prefix in a sub format string refused");
+    }
+}
+
+// Stands in for a device tick counter; the tests move it by hand.
+struct ManualClock {
+    using duration                  = std::chrono::milliseconds;
+    using rep                       = duration::rep;
+    using period                    = duration::period;
+    using time_point                = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static inline time_point current{};
+
+    static time_point now() { return current; }
+};
+
+void repeatFilter() {
+    using Filter  = remote_fmt::RepeatFilter<ManualClock, 2>;
+    using Printer = remote_fmt::Printer<VectorBackend, Filter>;
+
+    auto parseAll = [](std::vector<std::byte> const& buffer) {
+        std::vector<std::string>   messages;
+        std::span<std::byte const> rest{buffer};
+        while(!rest.empty()) {
+            auto const [message, remaining, discarded]
+              = remote_fmt::parse(rest, emptyCatalog(), [](std::string_view) {});
+            if(!message) { break; }
+            messages.push_back(*message);
+            rest = remaining;
+        }
+        return messages;
+    };
+
+    {
+        ManualClock::current = {};
+        Printer printer{Filter{100ms}};
+        for(int i = 0; i < 5; ++i) { printer.print("fault {}"_sc, 7); }
+        printer.print("fault {}"_sc, 8);
+        CHECK((parseAll(printer.get_com_backend().memory)
+               == std::vector<std::string>{"fault 7", "fault 8"}),
+              "identical frames held back, different arguments are not");
+
+        // The count goes out once the window has passed, ahead of the frame that noticed it.
+        ManualClock::current += 150ms;
+        printer.print("fault {}"_sc, 7);
+        CHECK((parseAll(printer.get_com_backend().memory)
+               == std::vector<std::string>{"fault 7",
+                                           "fault 8",
+                                           "\"fault {}\" repeated 4 times",
+                                           "fault 7"}),
+              "repeat notice after the window");
+    }
+    {
+        // Two slots: a third distinct frame evicts the oldest, which reports its count first.
+        ManualClock::current = {};
+        Printer printer{Filter{1s}};
+        printer.print("a {}"_sc, 1);
+        printer.print("a {}"_sc, 1);
+        ManualClock::current += 1ms;
+        printer.print("b {}"_sc, 2);
+        ManualClock::current += 1ms;
+        printer.print("c {}"_sc, 3);
+        CHECK((parseAll(printer.get_com_backend().memory)
+               == std::vector<std::string>{"a 1", "b 2", "\"a {}\" repeated 1 time", "c 3"}),
+              "evicted entry reports its count");
+    }
+    {
+        // flush_repeats reports without waiting, and the notice keeps the level of the message.
+        ManualClock::current = {};
+        Printer printer{Filter{1s}};
+        for(int i = 0; i < 3; ++i) { printer.print<remote_fmt::Level::error>("storm"_sc); }
+        printer.flush_repeats();
+
+        auto const& buffer = printer.get_com_backend().memory;
+        auto const [first, rest, discarded]
+          = remote_fmt::parse(std::span{buffer}, emptyCatalog(), [](std::string_view) {});
+        auto const [message, remaining, discarded2, level]
+          = remote_fmt::parseWithLevel(rest, emptyCatalog(), [](std::string_view) {});
+        CHECK(first.has_value() && *first == "storm", "first frame sent");
+        CHECK(message.has_value() && *message == "\"storm\" repeated 2 times", "flushed notice");
+        CHECK(level == remote_fmt::Level::error, "notice carries the level");
+        CHECK(remaining.empty(), "nothing else sent");
+    }
+}
+
+// A transport with a fixed number of free bytes, refilled by hand.
+struct LimitedBackend {
+    std::vector<std::byte> memory;
+    std::size_t            free{};
+    std::size_t            reserved{};
+
+    bool reserve(std::size_t size) {
+        if(size > free) { return false; }
+        free -= size;
+        reserved += size;
+        return true;
+    }
+
+    void write(std::span<std::byte const> data) {
+        memory.insert(memory.end(), data.begin(), data.end());
+    }
+};
+
+void dropAccounting() {
+    using Printer = remote_fmt::Printer<LimitedBackend>;
+
+    Printer printer{};
+    auto&   backend = printer.get_com_backend();
+
+    // Fixed-size arguments reserve their compile-time bound: markers, header with the 8
+    // characters, one 4-byte int with its identifier.
+    backend.free = 2 + 2 + 8 + 5;
+    printer.print("drops {}"_sc, 1);
+    printer.print("drops {}"_sc, 2);
+    printer.print("drops {}"_sc, 3);
+    auto const afterFirst = backend.memory.size();
+    CHECK(afterFirst == backend.reserved, "frame fits its reservation");
+    CHECK(printer.get_dropped_frames() == 2, "frames without room counted");
+    {
+        Printer const copy{printer};
+        CHECK(copy.get_dropped_frames() == 2, "a copy takes the drop count along");
+    }
+    static_assert(sizeof(remote_fmt::Printer<VectorBackend>) == sizeof(VectorBackend),
+                  "no drop counter for a backend that never drops");
+
+    // The next frame that fits reports the two in front of its format string.
+    backend.free = 64;
+    printer.print("drops {}"_sc, 4);
+    CHECK(printer.get_dropped_frames() == 0, "count cleared once reported");
+
+    std::string                      errors;
+    std::span<std::byte const> const buffer{backend.memory};
+    auto const [message, remaining, discarded, info] = remote_fmt::parseFrame(
+      buffer.subspan(afterFirst),
+      emptyCatalog(),
+      [&](std::string_view error) { errors += error; });
+    CHECK(message.has_value() && *message == "drops 4", "frame after drops parses");
+    CHECK(info.dropped_before == 2, "drop count surfaced");
+    CHECK(errors.find("2 frames dropped") != std::string::npos, "drop count reported as error");
+    CHECK(remaining.empty() && discarded == 0, "buffer fully consumed");
+
+    {
+        // The same frame without its argument: rejected, so its drop report is not believed.
+        std::vector<std::byte> corrupted{buffer.begin() + static_cast<std::ptrdiff_t>(afterFirst),
+                                         buffer.end()};
+        corrupted.erase(corrupted.end() - 6, corrupted.end() - 1);
+        remote_fmt::ParseStats stats{};
+        std::string            corruptedErrors;
+        auto const [corruptedMessage, corruptedRemaining, corruptedDiscarded, corruptedInfo]
+          = remote_fmt::parseFrame(std::span<std::byte const>{corrupted},
+                                   emptyCatalog(),
+                                   [&](std::string_view error) { corruptedErrors += error; },
+                                   stats);
+        CHECK(!corruptedMessage && stats.rejected_frames == 1, "corrupted frame rejected");
+        CHECK(corruptedInfo.dropped_before == 0 && stats.dropped_by_device == 0
+                && corruptedErrors.find("dropped") == std::string::npos,
+              "drop report of a rejected frame not counted");
+    }
+
+    // A string argument has no bound, so the frame is counted exactly before it is reserved.
+    backend.memory.clear();
+    backend.reserved = 0;
+    backend.free     = 64;
+    printer.print("{} {}"_sc, "variable"sv, 1);
+    CHECK(backend.memory.size() == backend.reserved, "counted frame reserves exactly");
+
+    // A frame that does not fit leaves nothing behind, not even its start marker.
+    backend.memory.clear();
+    backend.free = 4;
+    printer.print("{} {}"_sc, "variable"sv, 1);
+    CHECK(backend.memory.empty(), "dropped frame sends nothing");
+    backend.free = 64;
+    printer.print("ok"_sc);
+    auto const [okMessage, okRemaining, okDiscarded]
+      = remote_fmt::parse(std::span{backend.memory}, emptyCatalog(), [](std::string_view) {});
+    CHECK(okMessage.has_value() && *okMessage == "ok", "message after a drop report");
+
+    {
+        // Two links with the same backend type count their drops apart.
+        Printer other{};
+        other.print("drops {}"_sc, 5);
+        CHECK(other.get_dropped_frames() == 1, "drop counted on its own link");
+        CHECK(printer.get_dropped_frames() == 0, "and not on the other");
+        backend.memory.clear();
+        printer.print("ok"_sc);
+        auto const [message, remaining, discarded, info] = remote_fmt::parseFrame(
+          std::span{backend.memory},
+          emptyCatalog(),
+          [](std::string_view) {});
+        CHECK(message.has_value() && info.dropped_before == 0, "no drops reported on this link");
+    }
+
+    {
+        // A frame the transport dropped is not one the repeat filter holds its repeats back for.
+        using Filter         = remote_fmt::RepeatFilter<ManualClock, 2>;
+        using FilterPrinter  = remote_fmt::Printer<LimitedBackend, Filter>;
+        ManualClock::current = {};
+        FilterPrinter filterPrinter{Filter{1s}};
+        auto&         limited = filterPrinter.get_com_backend();
+
+        filterPrinter.print("fault {}"_sc, 7);
+        CHECK(limited.memory.empty(), "frame without room dropped");
+        limited.free = 64;
+        filterPrinter.print("fault {}"_sc, 7);
+        filterPrinter.print("fault {}"_sc, 7);
+        filterPrinter.flush_repeats();
+
+        std::span<std::byte const> rest{limited.memory};
+        auto const [first, afterFirst, firstDiscarded, firstInfo]
+          = remote_fmt::parseFrame(rest, emptyCatalog(), [](std::string_view) {});
+        CHECK(first.has_value() && *first == "fault 7", "repeat of a dropped frame sent");
+        CHECK(firstInfo.dropped_before == 1, "dropped frame reported");
+        auto const [notice, afterNotice, noticeDiscarded]
+          = remote_fmt::parse(afterFirst, emptyCatalog(), [](std::string_view) {});
+        CHECK(notice.has_value() && *notice == "\"fault {}\" repeated 1 time",
+              "only the repeat after the sent frame held back");
+        CHECK(afterNotice.empty(), "nothing else sent");
+    }
+}
+
 void malformedInput() {
     {
         auto const [message, remaining, discarded] = remote_fmt::parse(std::span<std::byte const>{},
@@ -928,6 +1626,145 @@ void malformedInput() {
         CHECK(!message, "bad format spec fails");
         CHECK(errorReported, "bad format spec reports an error");
     }
+
+    {
+        // A sink deriving from NullSink is told the category and no message.
+        struct CategorySink : remote_fmt::NullSink {
+            std::vector<remote_fmt::ParseError>& reported;
+            void operator()(remote_fmt::ParseError error) const { reported.push_back(error); }
+        };
+        std::vector<remote_fmt::ParseError> reported;
+        auto const buffer = rawStringFrame("{:d}", "not a number");
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{buffer}, emptyCatalog(), CategorySink{{}, reported});
+        CHECK(!message, "bad format spec fails with a null sink");
+        CHECK((reported == std::vector{remote_fmt::ParseError::format}),
+              "null sink told the category");
+
+        auto const good = serialize("Test {}"_sc, 123);
+        auto const [goodMessage, goodRemaining, goodDiscarded]
+          = remote_fmt::parse(std::span{good}, emptyCatalog(), remote_fmt::NullSink{});
+        CHECK(goodMessage.has_value() && *goodMessage == "Test 123", "null sink parses");
+    }
+
+    {
+        // Optionals nested by hand, one level more than max_parse_depth allows and one level
+        // fewer: the bytes one optional adds in front of the value, repeated.
+        auto const plain    = serialize("{}"_sc, 5);
+        auto const optional = serialize("{}"_sc, std::optional<int>{5});
+        auto const valueAt  = std::ranges::mismatch(plain, optional).in1 - plain.begin();
+        auto const levelSize = std::ssize(optional) - std::ssize(plain);
+        auto const nested = [&](std::size_t levels) {
+            std::vector<std::byte> buffer{plain.begin(), std::next(plain.begin(), valueAt)};
+            for(std::size_t level = 0; level < levels; ++level) {
+                buffer.insert(buffer.end(),
+                              std::next(optional.begin(), valueAt),
+                              std::next(optional.begin(), valueAt + levelSize));
+            }
+            buffer.insert(buffer.end(), std::next(plain.begin(), valueAt), plain.end());
+            return buffer;
+        };
+
+        std::vector<remote_fmt::ParseError> reported;
+        auto const                          tooDeep = nested(remote_fmt::max_parse_depth);
+        auto const [message, remaining, discarded]
+          = remote_fmt::parse(std::span{tooDeep},
+                              emptyCatalog(),
+                              [&](remote_fmt::ParseError error, std::string_view) {
+                                  reported.push_back(error);
+                              });
+        CHECK(!message, "nesting past the limit fails");
+        CHECK((reported == std::vector{remote_fmt::ParseError::too_deep}),
+              "nesting past the limit reported once");
+
+        auto const deepest = nested(remote_fmt::max_parse_depth - 1);
+        auto const [deepMessage, deepRemaining, deepDiscarded]
+          = remote_fmt::parse(std::span{deepest}, emptyCatalog(), remote_fmt::NullSink{});
+        CHECK(deepMessage.has_value() && deepMessage->contains("optional(5)"),
+              "nesting at the limit parses");
+    }
+}
+
+void parseStatistics() {
+    // Noise, a good frame, a frame fmt rejects, one with an unknown catalog id and half a frame.
+    std::vector<std::byte> stream{std::byte{0x00}, std::byte{0x13}};
+    auto const             good = serialize("Test {}"_sc, 123);
+    stream.insert(stream.end(), good.begin(), good.end());
+    auto const badSpec = rawStringFrame("{:d}", "not a number");
+    stream.insert(stream.end(), badSpec.begin(), badSpec.end());
+    using remote_fmt::detail::FmtStringType;
+    std::array const unknownId{
+      remote_fmt::protocol::Start_marker,
+      remote_fmt::detail::fmtStringTypeIdentifier<FmtStringType::cataloged_normal>(
+        remote_fmt::detail::RangeSize::_2),
+      std::byte{0x34},
+      std::byte{0x12},
+      remote_fmt::protocol::End_marker};
+    stream.insert(stream.end(), unknownId.begin(), unknownId.end());
+    stream.insert(stream.end(), good.begin(), std::next(good.begin(), 4));
+
+    remote_fmt::TimedParseStats         stats{};
+    std::vector<remote_fmt::ParseError> reported;
+    std::span<std::byte const>          rest{stream};
+    std::size_t                         messages{};
+    for(int call = 0; call < 4; ++call) {
+        auto const [message, remaining, discarded] = remote_fmt::parse(
+          rest,
+          emptyCatalog(),
+          [&](remote_fmt::ParseError error, std::string_view) { reported.push_back(error); },
+          stats);
+        if(message) {
+            ++messages;
+            rest = remaining;
+        } else if(call < 3) {
+            rest = remaining.subspan(1);
+        }
+    }
+
+    CHECK(messages == 1 && stats.frames == 1, "one frame parsed");
+    CHECK(stats.frame_bytes == good.size(), "bytes of the parsed frame");
+    CHECK(stats.rejected_frames == 2, "complete frames that did not parse");
+    // The noise, and what follows the start marker of each rejected frame.
+    CHECK(stats.discarded_bytes == 2 + badSpec.size() - 1 + unknownId.size() - 1,
+          "bytes skipped while resyncing");
+    CHECK(stats[remote_fmt::ParseError::format] == 1, "fmt failure counted");
+    CHECK(stats[remote_fmt::ParseError::catalog_miss] == 1, "catalog miss counted");
+    CHECK((reported
+           == std::vector{remote_fmt::ParseError::format, remote_fmt::ParseError::catalog_miss}),
+          "callback told the category");
+    CHECK(stats[remote_fmt::ParseStage::decode] + stats[remote_fmt::ParseStage::format]
+            > std::chrono::nanoseconds{},
+          "stages timed");
+
+    // Untimed stats count the same and leave the clock alone.
+    remote_fmt::ParseStats untimed{};
+    auto const [message, remaining, discarded]
+      = remote_fmt::parse(std::span{good}, emptyCatalog(), [](std::string_view) {}, untimed);
+    CHECK(message.has_value() && untimed.frames == 1 && untimed.frame_bytes == good.size(),
+          "untimed stats count");
+    CHECK(untimed[remote_fmt::ParseStage::decode] == std::chrono::nanoseconds{}, "no stage times");
+
+    // A FrameParser keeps its callback and stats from one call to the next.
+    std::vector<remote_fmt::ParseError> held;
+    remote_fmt::FrameParser             parser{
+      [&](remote_fmt::ParseError error, std::string_view) { held.push_back(error); },
+      remote_fmt::ParseStats{}};
+    std::span<std::byte const> heldRest{stream};
+    std::size_t                heldMessages{};
+    for(int call = 0; call < 4; ++call) {
+        auto const [message, remaining, discarded] = parser.parse(heldRest, emptyCatalog());
+        if(message) {
+            ++heldMessages;
+            heldRest = remaining;
+        } else if(call < 3) {
+            heldRest = remaining.subspan(1);
+        }
+    }
+    CHECK(heldMessages == 1 && parser.get_stats().frames == 1, "kept parser parses the frame");
+    CHECK(parser.get_stats().rejected_frames == 2, "kept parser counts across calls");
+    CHECK((held
+           == std::vector{remote_fmt::ParseError::format, remote_fmt::ParseError::catalog_miss}),
+          "kept parser calls back across calls");
 }
 
 }   // namespace
@@ -939,6 +1776,12 @@ int main() {
     tupleRoundTrips();
     extendedTypeRoundTrips();
     timeRoundTrips();
+    compactTimeEncoding();
+    packedFlags();
+    schemaRanges();
+    aggregateRoundTrips();
+    bulkRanges();
+    unsizedRanges();
     debugFormatInRanges();
     replacementFieldNumberLimit();
     fmtParityScalars();
@@ -954,7 +1797,11 @@ int main() {
     optionalInsideWrapperQuirk();
     enumFormatting();
     multipleMessages();
+    leveledPrint();
+    repeatFilter();
+    dropAccounting();
     malformedInput();
+    parseStatistics();
 
     if(failures != 0) {
         std::printf("%d test(s) failed\n", failures);
@@ -0,0 +1,183 @@
+// Tests for the wire report: every byte of a capture is accounted for exactly once, in the
+// category and under the types the encoding spends it on, whether the capture is analyzed at once
+// or as it arrives.
+#include "remote_fmt/wire_report.hpp"
+
+#include "remote_fmt/remote_fmt.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace sc::literals;
+using namespace std::literals;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, msg)                                        \
+    do {                                                        \
+        if(!(cond)) {                                           \
+            std::printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            ++failures;                                         \
+        }                                                       \
+    } while(0)
+
+struct VectorBackend {
+    std::vector<std::byte> memory;
+
+    void write(std::span<std::byte const> data) {
+        memory.insert(memory.end(), data.begin(), data.end());
+    }
+};
+
+struct Point {
+    std::int32_t x;
+    std::int32_t y;
+};
+
+using remote_fmt::WireCategory;
+using remote_fmt::detail::RangeType;
+using remote_fmt::detail::TrivialType;
+using remote_fmt::detail::TypeIdentifier;
+
+std::unordered_map<std::uint16_t, std::string> const noCatalog{};
+
+std::vector<std::byte> frame(auto fmtString, auto const&... args) {
+    remote_fmt::Printer<VectorBackend> printer{};
+    printer.print(fmtString, args...);
+    return printer.get_com_backend().memory;
+}
+
+void append(std::vector<std::byte>&       capture,
+            std::vector<std::byte> const& bytes) {
+    capture.insert(capture.end(), bytes.begin(), bytes.end());
+}
+
+std::uint64_t sum(auto const& tallies) {
+    std::uint64_t bytes = 0;
+    for(auto const& [key, tally] : tallies) { bytes += tally.total(); }
+    return bytes;
+}
+
+}   // namespace
+
+int main() {
+    {
+        auto const capture = frame("Test {}"_sc, std::uint8_t{123});
+        auto const report  = remote_fmt::analyzeWire(capture, noCatalog);
+        CHECK(report.total.count == 1 && report.rejected_frames == 0, "one frame");
+        CHECK(report.total.total() == capture.size(), "every byte counted");
+        // Start and end marker; identifier and length of the format string, then its text; the
+        // argument's identifier and its one byte.
+        CHECK(report.total[WireCategory::framing] == 2, "markers");
+        CHECK(report.total[WireCategory::type_identifier] == 2, "identifiers");
+        CHECK(report.total[WireCategory::size] == 1, "format string length");
+        CHECK(report.total[WireCategory::format_string] == 7, "format string text");
+        CHECK(report.total[WireCategory::payload] == 1, "value");
+        CHECK(report.by_inline_format.contains("Test {}")
+                && report.by_inline_format.find("Test {}")->second.total() == capture.size(),
+              "tallied under its format string");
+        auto const& unsignedTally = report.by_trivial_type.at(TrivialType::unsigned_);
+        CHECK(unsignedTally.count == 1 && unsignedTally.total() == 2, "tallied under its type");
+        CHECK(report.by_type_identifier.at(TypeIdentifier::trivial).total() == 2,
+              "tallied under its identifier");
+    }
+
+    {
+        // A compact range: one identifier for all elements.
+        auto const capture = frame("{}"_sc, std::vector<std::uint16_t>{1, 2, 3});
+        auto const report  = remote_fmt::analyzeWire(capture, noCatalog);
+        auto const& list   = report.by_range_type.at(RangeType::list);
+        CHECK(list.count == 1, "one list");
+        CHECK(list[WireCategory::type_identifier] == 2 && list[WireCategory::size] == 1,
+              "range and element identifier, count");
+        CHECK(list[WireCategory::payload] == 6, "elements");
+        auto const& unsignedTally = report.by_trivial_type.at(TrivialType::unsigned_);
+        CHECK(unsignedTally.count == 3 && unsignedTally.total() == 7, "elements by type");
+    }
+
+    {
+        auto const capture = frame("{} {}"_sc, "abc"sv, Point{1, -2});
+        auto const report  = remote_fmt::analyzeWire(capture, noCatalog);
+        auto const& string = report.by_range_type.at(RangeType::string);
+        CHECK(string[WireCategory::size] == 1 && string[WireCategory::payload] == 3, "string");
+        // The schema "x:i4,y:i4" goes as text without a catalog.
+        auto const& aggregate = report.by_range_type.at(RangeType::extendedTypeIdentifier);
+        CHECK(aggregate[WireCategory::payload] == 8, "struct fields");
+        CHECK(report.by_trivial_type.at(TrivialType::signed_).count == 2, "fields by type");
+        CHECK(report.total.total() == capture.size(), "every byte counted");
+    }
+
+    {
+        auto const capture = frame("{} {} {}"_sc, true, false, true);
+        auto const report  = remote_fmt::analyzeWire(capture, noCatalog);
+        auto const& flags  = report.by_trivial_type.at(TrivialType::boolean);
+        CHECK(flags.count == 3 && flags.total() == 2, "bools packed into one group");
+    }
+
+    // Several frames, with noise in between and the start of one more at the end.
+    std::vector<std::byte> capture;
+    append(capture, frame("Test {}"_sc, std::uint8_t{1}));
+    append(capture, {std::byte{0x01}, std::byte{0x02}});
+    append(capture, frame("{}"_sc, std::chrono::milliseconds{5}));
+    append(capture, frame("{}"_sc, std::optional<int>{7}));
+    append(capture, frame("{}"_sc, std::vector<std::chrono::microseconds>{1us, 2us}));
+    append(capture, frame("Test {}"_sc, std::uint8_t{2}));
+    auto const tail = frame("{}"_sc, 1.5F);
+    append(capture, std::vector<std::byte>(tail.begin(), tail.begin() + 4));
+
+    {
+        auto const report = remote_fmt::analyzeWire(capture, noCatalog);
+        CHECK(report.total.count == 5, "all complete frames");
+        CHECK(report.unparsed_bytes == 2 + 4, "noise and the cut off frame");
+        CHECK(report.total.total() + report.unparsed_bytes == capture.size(),
+              "every byte counted once");
+        CHECK(sum(report.by_inline_format) == report.total.total(), "per format string");
+        CHECK(report.by_inline_format.find("Test {}")->second.count == 2, "frames per format");
+        CHECK(report.by_type_identifier.at(TypeIdentifier::time).count == 1, "one duration");
+        CHECK(report.by_range_type.at(RangeType::extendedTypeIdentifier).count == 1,
+              "one optional");
+        std::uint64_t const overhead = report.total[WireCategory::framing]
+                                     + report.total[WireCategory::format_string]
+                                     + 5 * 2;   // identifier and length of each format string
+        CHECK(sum(report.by_type_identifier) + overhead == report.total.total(),
+              "per argument type");
+    }
+
+    {
+        // The same capture as it arrives, in pieces of seven bytes.
+        remote_fmt::WireReport     report{};
+        std::vector<std::byte>     pending;
+        std::span<std::byte const> rest{capture};
+        while(!rest.empty()) {
+            auto const piece = rest.first(std::min<std::size_t>(7, rest.size()));
+            rest             = rest.subspan(piece.size());
+            append(pending, {piece.begin(), piece.end()});
+            auto const remaining = remote_fmt::analyzeWire(pending, noCatalog, report);
+            pending.erase(pending.begin(),
+                          pending.begin()
+                            + static_cast<std::ptrdiff_t>(pending.size() - remaining.size()));
+        }
+        auto const whole = remote_fmt::analyzeWire(capture, noCatalog);
+        CHECK(report.total.count == whole.total.count
+                && report.total.bytes == whole.total.bytes,
+              "streamed like captured");
+        CHECK(pending.size() == 4, "the cut off frame waits for the rest");
+    }
+
+    if(failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all wire report tests passed\n");
+    return 0;
+}
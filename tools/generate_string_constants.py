@@ -67,6 +67,7 @@ def parse_StringConstant(s):
 def parse_symbol(symbol):
     """Extract the string constant from a symbol name."""
     symbol = symbol.removeprefix("unsigned short remote_fmt::catalog<")
+    symbol = symbol.removeprefix("remote_fmt::EnumNames<")
     symbol = symbol.removesuffix(">")
 
     result = parse_StringConstant(symbol)
@@ -76,6 +77,11 @@ def parse_symbol(symbol):
     return result
 
 
+def is_enum_names(symbol):
+    """An enum name table takes one id per enumerator, starting at the id catalog<>() returns."""
+    return symbol.startswith("unsigned short remote_fmt::catalog<remote_fmt::EnumNames<")
+
+
 # Check if tools are available
 if not shutil.which(args.nm):
     print(f"Error: nm '{args.nm}' not found.", file=sys.stderr)
@@ -102,11 +108,14 @@ for f in args.objects:
         print("Error: nm command not found.", file=sys.stderr)
         sys.exit(1)
     for line in iter(x.stdout.splitlines()):
-        if line.strip().startswith("U unsigned short remote_fmt::catalog<sc::StringConstant<"):
+        if line.strip().startswith("U unsigned short remote_fmt::catalog<sc::StringConstant<") or \
+                line.strip().startswith("U unsigned short remote_fmt::catalog<remote_fmt::EnumNames<"):
             symbols.append(line.strip().removeprefix("U "))
 
+# Enum name tables first: the device sends an id below 256 in one byte, and enum values are the
+# arguments that repeat most.
 symbols = list(set(symbols))
-symbols.sort()
+symbols.sort(key=lambda symbol: (not is_enum_names(symbol), symbol))
 outfilename = os.path.join(
     args.out_dir, f"{args.target_name}_string_constants.cpp")
 jsonfilename = os.path.join(
@@ -125,15 +134,18 @@ try:
             outfile.write("{return ")
             outfile.write(str(id))
             outfile.write(";}\n")
-            entry = []
-            entry.append(id)
             parsed_symbol = parse_symbol(s)
             if parsed_symbol is None:
                 print(f"Skipping invalid symbol: {s}", file=sys.stderr)
                 continue
-            entry.append(parsed_symbol)
-            indexmap.append(entry)
-            id = id+1
+            if is_enum_names(s):
+                names = parsed_symbol.split(",") if parsed_symbol else []
+                for name in names:
+                    indexmap.append([id, name])
+                    id = id+1
+            else:
+                indexmap.append([id, parsed_symbol])
+                id = id+1
         outfile.write("\n")
 except IOError as e:
     print(f"Error writing C++ file '{outfilename}': {e}", file=sys.stderr)
@@ -0,0 +1,137 @@
+// Prints where the bytes of a capture go: framing, type identifiers, sizes, catalog ids, format
+// string text and payload, for the whole capture, per format string and per argument type.
+//
+//   remote_fmt_wire_report capture.bin [target_string_constants.json]
+//
+// The catalog is needed for captures from a catalog build, to follow cataloged format strings
+// and to show their text next to their ids.
+#include "remote_fmt/catalog_helpers.hpp"
+#include "remote_fmt/wire_report.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using remote_fmt::WireCategory;
+using remote_fmt::WireTally;
+
+double percent(std::uint64_t part,
+               std::uint64_t whole) {
+    return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+void printHeader(std::string_view title) {
+    fmt::print("\n{:<40} {:>8} {:>10}", title, "count", "bytes");
+    for(auto const category : enchantum::values<WireCategory>) {
+        fmt::print(" {:>15}", enchantum::to_string(category));
+    }
+    fmt::print("\n");
+}
+
+void printRow(std::string_view name,
+              WireTally const& tally) {
+    fmt::print("{:<40} {:>8} {:>10}", name, tally.count, tally.total());
+    for(auto const category : enchantum::values<WireCategory>) {
+        fmt::print(" {:>15}", tally[category]);
+    }
+    fmt::print("\n");
+}
+
+template<typename Key,
+         typename Compare>
+void printTable(std::string_view                         title,
+                std::map<Key, WireTally, Compare> const& tallies,
+                auto                                     name) {
+    if(tallies.empty()) { return; }
+    printHeader(title);
+    std::vector<std::pair<Key, WireTally>> rows(tallies.begin(), tallies.end());
+    std::ranges::stable_sort(rows, [](auto const& lhs, auto const& rhs) {
+        return lhs.second.total() > rhs.second.total();
+    });
+    for(auto const& [key, tally] : rows) { printRow(name(key), tally); }
+}
+
+std::string shortened(std::string_view text) {
+    constexpr std::size_t width = 38;
+    std::string           quoted = fmt::format("{:?}", text);
+    if(quoted.size() > width) { quoted = quoted.substr(0, width - 3) + "..."; }
+    return quoted;
+}
+
+}   // namespace
+
+int main(int    argc,
+         char** argv) {
+    std::span const args{argv, static_cast<std::size_t>(argc)};
+    if(args.size() < 2 || args.size() > 3) {
+        fmt::print(stderr, "usage: {} capture [string_constants.json]\n", args[0]);
+        return 2;
+    }
+
+    std::unordered_map<std::uint16_t, std::string> stringConstantsMap;
+    if(args.size() == 3) {
+        auto catalog = remote_fmt::parseStringConstantsFromJsonFile(args[2]);
+        if(!catalog) {
+            fmt::print(stderr, "{}\n", catalog.error());
+            return 1;
+        }
+        stringConstantsMap = std::move(*catalog);
+    }
+
+    std::ifstream file{args[1], std::ios::binary};
+    if(!file) {
+        fmt::print(stderr, "cannot open {}\n", args[1]);
+        return 1;
+    }
+    std::vector<char> const raw{std::istreambuf_iterator<char>{file}, {}};
+    std::vector<std::byte>  capture(raw.size());
+    std::ranges::transform(raw, capture.begin(), [](char c) { return static_cast<std::byte>(c); });
+
+    auto const report = remote_fmt::analyzeWire(capture, stringConstantsMap);
+
+    fmt::print("{} bytes, {} frames, {} bytes unparsed ({} frames rejected)\n\n",
+               capture.size(),
+               report.total.count,
+               report.unparsed_bytes,
+               report.rejected_frames);
+    for(auto const category : enchantum::values<WireCategory>) {
+        fmt::print("{:<16} {:>12} {:>6.1f}%\n",
+                   enchantum::to_string(category),
+                   report.total[category],
+                   percent(report.total[category], capture.size()));
+    }
+
+    printTable("catalog id", report.by_catalog_id, [&](std::uint16_t id) {
+        auto const text = stringConstantsMap.find(id);
+        return text == stringConstantsMap.end()
+               ? fmt::format("{}", id)
+               : fmt::format("{} {}", id, shortened(text->second));
+    });
+    printTable("inline format string", report.by_inline_format, [](std::string const& text) {
+        return shortened(text);
+    });
+    printTable("type identifier", report.by_type_identifier, [](auto typeId) {
+        return std::string{enchantum::to_string(typeId)};
+    });
+    printTable("range type", report.by_range_type, [](auto rangeType) {
+        return std::string{enchantum::to_string(rangeType)};
+    });
+    printTable("trivial type", report.by_trivial_type, [](auto trivialType) {
+        return std::string{enchantum::to_string(trivialType)};
+    });
+    return 0;
+}